@@ -6,21 +6,32 @@
 
 #ifndef CPP_UTILITIES_THREAD_LOCAL
 #define CPP_UTILITIES_THREAD_LOCAL
+#define CPP_UTILITIES_NO_STRING_CONVERTER_CACHE
 #endif
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <iomanip>
 #include <memory>
+#include <new>
 #include <sstream>
+#include <utility>
 
 #ifdef PLATFORM_WINDOWS
-#include <algorithm> // for std::clamp
 #include <limits>
 #endif
 
 #include <errno.h>
 
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #ifndef CPP_UTILITIES_NO_ICONV
 #include <iconv.h>
 #endif
@@ -40,173 +51,758 @@ using namespace std;
 
 namespace CppUtilities {
 
-#ifndef CPP_UTILITIES_NO_ICONV
-
 /// \cond
 
-struct Keep {
-    size_t operator()(size_t value)
-    {
-        return value;
+/*!
+ * \brief Decodes the UTF-8 sequence at \a input.
+ * \returns Returns the length of the sequence, 0 if it is a valid but incomplete prefix or -1 if it is invalid.
+ * \remarks Overlong encodings, surrogates and code points beyond U+10FFFF are considered invalid.
+ */
+static int decodeUtf8Sequence(const unsigned char *input, const unsigned char *end, char32_t &codePoint)
+{
+    const auto lead = *input;
+    if (lead < 0x80) {
+        codePoint = lead;
+        return 1;
     }
-};
-struct Double {
-    size_t operator()(size_t value)
-    {
-        return value + value;
+    auto length = 0;
+    auto min = static_cast<unsigned char>(0x80), max = static_cast<unsigned char>(0xBF);
+    if (lead < 0xC2) {
+        return -1;
+    } else if (lead < 0xE0) {
+        length = 2;
+        codePoint = lead & 0x1Fu;
+    } else if (lead < 0xF0) {
+        length = 3;
+        codePoint = lead & 0x0Fu;
+        if (lead == 0xE0) {
+            min = 0xA0;
+        } else if (lead == 0xED) {
+            max = 0x9F;
+        }
+    } else if (lead < 0xF5) {
+        length = 4;
+        codePoint = lead & 0x07u;
+        if (lead == 0xF0) {
+            min = 0x90;
+        } else if (lead == 0xF4) {
+            max = 0x8F;
+        }
+    } else {
+        return -1;
     }
-};
-struct Half {
-    size_t operator()(size_t value)
-    {
-        return value / 2;
+    for (auto i = 1; i != length; ++i, min = 0x80, max = 0xBF) {
+        if (input + i >= end) {
+            return 0;
+        }
+        const auto c = input[i];
+        if (c < min || c > max) {
+            return -1;
+        }
+        codePoint = (codePoint << 6) | (c & 0x3Fu);
     }
-};
-struct Factor {
-    Factor(float factor)
-        : factor(factor) {};
-    size_t operator()(size_t value)
-    {
-        return static_cast<size_t>(static_cast<float>(value) * factor);
-    }
-    float factor;
-};
+    return length;
+}
 
-template <class OutputSizeHint> class ConversionDescriptor {
-public:
-    ConversionDescriptor(const char *fromCharset, const char *toCharset)
-        : m_ptr(iconv_open(toCharset, fromCharset))
-        , m_outputSizeHint(OutputSizeHint())
-    {
-        if (m_ptr == reinterpret_cast<iconv_t>(-1)) {
-            throw ConversionException("Unable to allocate descriptor for character set conversion.");
+/*!
+ * \brief Decodes the UTF-16 sequence at \a input.
+ * \returns Returns the length of the sequence in bytes, 0 if it is incomplete or -1 if it is an unpaired surrogate.
+ */
+template <bool bigEndian> static int decodeUtf16Sequence(const unsigned char *input, const unsigned char *end, char32_t &codePoint)
+{
+    const auto readUnit = [](const unsigned char *i) {
+        return bigEndian ? static_cast<char32_t>((i[0] << 8) | i[1]) : static_cast<char32_t>((i[1] << 8) | i[0]);
+    };
+    if (end - input < 2) {
+        return 0;
+    }
+    const auto unit = readUnit(input);
+    if (unit < 0xD800 || unit > 0xDFFF) {
+        codePoint = unit;
+        return 2;
+    }
+    if (unit > 0xDBFF) {
+        return -1;
+    }
+    if (end - input < 4) {
+        return 0;
+    }
+    const auto lowSurrogate = readUnit(input + 2);
+    if (lowSurrogate < 0xDC00 || lowSurrogate > 0xDFFF) {
+        return -1;
+    }
+    codePoint = 0x10000 + ((unit - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+    return 4;
+}
+
+template <bool bigEndian> inline void writeUtf16Unit(unsigned char *&output, char32_t unit)
+{
+    const auto high = static_cast<unsigned char>(unit >> 8), low = static_cast<unsigned char>(unit);
+    *output++ = bigEndian ? high : low;
+    *output++ = bigEndian ? low : high;
+}
+
+/*!
+ * \brief Writes \a codePoint as UTF-16 to \a output if there is enough space left.
+ */
+template <bool bigEndian> inline bool writeUtf16(unsigned char *&output, unsigned char *outputEnd, char32_t codePoint)
+{
+    if (codePoint < 0x10000) {
+        if (outputEnd - output < 2) {
+            return false;
         }
+        writeUtf16Unit<bigEndian>(output, codePoint);
+    } else {
+        if (outputEnd - output < 4) {
+            return false;
+        }
+        codePoint -= 0x10000;
+        writeUtf16Unit<bigEndian>(output, 0xD800 + (codePoint >> 10));
+        writeUtf16Unit<bigEndian>(output, 0xDC00 + (codePoint & 0x3FF));
     }
+    return true;
+}
 
-    ConversionDescriptor(const char *fromCharset, const char *toCharset, OutputSizeHint outputSizeHint)
-        : m_ptr(iconv_open(toCharset, fromCharset))
-        , m_outputSizeHint(outputSizeHint)
-    {
-        if (m_ptr == reinterpret_cast<iconv_t>(-1)) {
-            throw ConversionException("Unable to allocate descriptor for character set conversion.");
+/*!
+ * \brief Writes \a codePoint as UTF-8 to \a output if there is enough space left.
+ */
+inline bool writeUtf8(unsigned char *&output, unsigned char *outputEnd, char32_t codePoint)
+{
+    const auto length = codePoint < 0x80 ? 1 : codePoint < 0x800 ? 2 : codePoint < 0x10000 ? 3 : 4;
+    if (outputEnd - output < length) {
+        return false;
+    }
+    switch (length) {
+    case 1:
+        *output++ = static_cast<unsigned char>(codePoint);
+        break;
+    case 2:
+        *output++ = static_cast<unsigned char>(0xC0 | (codePoint >> 6));
+        *output++ = static_cast<unsigned char>(0x80 | (codePoint & 0x3F));
+        break;
+    case 3:
+        *output++ = static_cast<unsigned char>(0xE0 | (codePoint >> 12));
+        *output++ = static_cast<unsigned char>(0x80 | ((codePoint >> 6) & 0x3F));
+        *output++ = static_cast<unsigned char>(0x80 | (codePoint & 0x3F));
+        break;
+    default:
+        *output++ = static_cast<unsigned char>(0xF0 | (codePoint >> 18));
+        *output++ = static_cast<unsigned char>(0x80 | ((codePoint >> 12) & 0x3F));
+        *output++ = static_cast<unsigned char>(0x80 | ((codePoint >> 6) & 0x3F));
+        *output++ = static_cast<unsigned char>(0x80 | (codePoint & 0x3F));
+    }
+    return true;
+}
+
+/*!
+ * \brief Implements the chunked conversion shared by Utf8ToUtf16Converter and Utf16ToUtf8Converter.
+ * \remarks
+ * - Encoding::decode() decodes one sequence (see decodeUtf8Sequence()) and Encoding::encode() writes one code point
+ *   (see writeUtf8()). Encoding::convertBlock() converts a run of ASCII characters at once if possible and returns
+ *   whether it did. Code points beyond Encoding::maxCodePoint can not be encoded and are treated as invalid input.
+ * - An incomplete sequence at the end of the input is stored in \a pendingInput and completed with the next input.
+ */
+template <class Encoding>
+static UnicodeConversionResult convertUnicode(std::string_view input, char *outputBuffer, std::size_t outputBufferSize,
+    unsigned char (&pendingInput)[3], unsigned char &pendingInputSize)
+{
+    constexpr auto decode = Encoding::decode;
+    constexpr auto encode = Encoding::encode;
+    constexpr auto convertBlock = Encoding::convertBlock;
+    const auto *const inputBegin = reinterpret_cast<const unsigned char *>(input.data());
+    const auto *const inputEnd = inputBegin + input.size();
+    auto *const outputBegin = reinterpret_cast<unsigned char *>(outputBuffer);
+    auto *const outputEnd = outputBegin + outputBufferSize;
+    const auto *in = inputBegin;
+    auto *out = outputBegin;
+    const auto result = [&](UnicodeConversionStatus status) {
+        return UnicodeConversionResult{ .bytesRead = static_cast<std::size_t>(in - inputBegin),
+            .bytesWritten = static_cast<std::size_t>(out - outputBegin),
+            .status = status };
+    };
+    auto codePoint = char32_t();
+
+    // complete the sequence left over from the previous input
+    if (pendingInputSize) {
+        unsigned char sequence[4];
+        const auto takenSize = std::min<std::size_t>(sizeof(sequence) - pendingInputSize, input.size());
+        std::memcpy(sequence, pendingInput, pendingInputSize);
+        std::memcpy(sequence + pendingInputSize, inputBegin, takenSize);
+        const auto length = decode(sequence, sequence + pendingInputSize + takenSize, codePoint);
+        if (length == 0) {
+            std::memcpy(pendingInput + pendingInputSize, inputBegin, takenSize);
+            pendingInputSize = static_cast<unsigned char>(pendingInputSize + takenSize);
+            in += takenSize;
+            return result(UnicodeConversionStatus::Ok);
+        } else if (length < 0 || codePoint > Encoding::maxCodePoint) {
+            pendingInputSize = 0;
+            return result(UnicodeConversionStatus::InvalidInput);
+        } else if (!encode(out, outputEnd, codePoint)) {
+            return result(UnicodeConversionStatus::OutputBufferTooSmall);
         }
+        in += length - pendingInputSize;
+        pendingInputSize = 0;
     }
 
-    ~ConversionDescriptor()
-    {
-        iconv_close(m_ptr);
-    }
-
-public:
-    StringData convertString(const char *inputBuffer, size_t inputBufferSize)
-    {
-        // setup input and output buffer
-        size_t inputBytesLeft = inputBufferSize;
-        size_t outputSize = m_outputSizeHint(inputBufferSize);
-        size_t outputBytesLeft = outputSize;
-        char *outputBuffer = reinterpret_cast<char *>(malloc(outputSize));
-        size_t bytesWritten;
-
-        char *currentOutputOffset = outputBuffer;
-        for (;; currentOutputOffset = outputBuffer + bytesWritten) {
-            bytesWritten = iconv(m_ptr, const_cast<char **>(&inputBuffer), &inputBytesLeft, &currentOutputOffset, &outputBytesLeft);
-            if (bytesWritten == static_cast<size_t>(-1)) {
-                if (errno == EINVAL) {
-                    // ignore incomplete multibyte sequence in the input
-                    bytesWritten = static_cast<size_t>(currentOutputOffset - outputBuffer);
-                    break;
-                } else if (errno == E2BIG) {
-                    // output buffer has no more room for next converted character
-                    bytesWritten = static_cast<size_t>(currentOutputOffset - outputBuffer);
-                    outputBytesLeft = (outputSize += m_outputSizeHint(inputBytesLeft)) - bytesWritten;
-                    outputBuffer = reinterpret_cast<char *>(realloc(outputBuffer, outputSize));
-                } else /*if(errno == EILSEQ)*/ {
-                    // invalid multibyte sequence in the input
-                    free(outputBuffer);
-                    throw ConversionException("Invalid multibyte sequence in the input.");
-                }
-            } else {
-                // conversion completed without (further) errors
-                break;
-            }
+    // convert the remaining input
+    while (in != inputEnd) {
+        if (convertBlock(in, inputEnd, out, outputEnd)) {
+            continue;
+        }
+        const auto length = decode(in, inputEnd, codePoint);
+        if (length == 0) {
+            pendingInputSize = static_cast<unsigned char>(inputEnd - in);
+            std::memcpy(pendingInput, in, pendingInputSize);
+            in = inputEnd;
+            break;
+        } else if (length < 0 || codePoint > Encoding::maxCodePoint) {
+            return result(UnicodeConversionStatus::InvalidInput);
+        } else if (!encode(out, outputEnd, codePoint)) {
+            return result(UnicodeConversionStatus::OutputBufferTooSmall);
+        }
+        in += length;
+    }
+    return result(UnicodeConversionStatus::Ok);
+}
+
+/*!
+ * \brief Converts 16 characters from UTF-8 to UTF-16 at once if the next 16 characters are ASCII.
+ */
+template <bool bigEndian>
+inline bool convertAsciiBlockToUtf16(const unsigned char *&input, const unsigned char *inputEnd, unsigned char *&output, unsigned char *outputEnd)
+{
+#ifdef __SSE2__
+    if (*input >= 0x80 || inputEnd - input < 16 || outputEnd - output < 32) {
+        return false;
+    }
+    const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input));
+    if (_mm_movemask_epi8(chars)) {
+        return false;
+    }
+    const auto zero = _mm_setzero_si128();
+    if constexpr (bigEndian) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(output), _mm_unpacklo_epi8(zero, chars));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(output + 16), _mm_unpackhi_epi8(zero, chars));
+    } else {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(output), _mm_unpacklo_epi8(chars, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(output + 16), _mm_unpackhi_epi8(chars, zero));
+    }
+    input += 16;
+    output += 32;
+    return true;
+#else
+    // convert ASCII characters directly without going through decoding/encoding
+    auto converted = false;
+    for (; input != inputEnd && *input < 0x80 && outputEnd - output >= 2; converted = true) {
+        writeUtf16Unit<bigEndian>(output, *input++);
+    }
+    return converted;
+#endif
+}
+
+/*!
+ * \brief Converts 16 characters from UTF-16 to UTF-8 at once if the next 16 characters are ASCII.
+ */
+template <bool bigEndian>
+inline bool convertAsciiBlockToUtf8(const unsigned char *&input, const unsigned char *inputEnd, unsigned char *&output, unsigned char *outputEnd)
+{
+#ifdef __SSE2__
+    if (inputEnd - input < 32 || outputEnd - output < 16 || input[bigEndian ? 0 : 1] || input[bigEndian ? 1 : 0] >= 0x80) {
+        return false;
+    }
+    auto units1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input));
+    auto units2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + 16));
+    if constexpr (bigEndian) {
+        units1 = _mm_or_si128(_mm_slli_epi16(units1, 8), _mm_srli_epi16(units1, 8));
+        units2 = _mm_or_si128(_mm_slli_epi16(units2, 8), _mm_srli_epi16(units2, 8));
+    }
+    const auto nonAsciiBits = _mm_and_si128(_mm_or_si128(units1, units2), _mm_set1_epi16(static_cast<short>(0xFF80)));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(nonAsciiBits, _mm_setzero_si128())) != 0xFFFF) {
+        return false;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(output), _mm_packus_epi16(units1, units2));
+    input += 32;
+    output += 16;
+    return true;
+#else
+    // convert ASCII characters directly without going through decoding/encoding
+    auto converted = false;
+    for (; inputEnd - input >= 2 && !input[bigEndian ? 0 : 1] && input[bigEndian ? 1 : 0] < 0x80 && output != outputEnd; converted = true) {
+        *output++ = input[bigEndian ? 1 : 0];
+        input += 2;
+    }
+    return converted;
+#endif
+}
+
+/*!
+ * \brief Decodes the Latin-1 character at \a input.
+ */
+inline int decodeLatin1(const unsigned char *input, const unsigned char *, char32_t &codePoint)
+{
+    codePoint = *input;
+    return 1;
+}
+
+/*!
+ * \brief Writes \a codePoint (which must be within the Latin-1 range) to \a output if there is enough space left.
+ */
+inline bool writeLatin1(unsigned char *&output, unsigned char *outputEnd, char32_t codePoint)
+{
+    if (output == outputEnd) {
+        return false;
+    }
+    *output++ = static_cast<unsigned char>(codePoint);
+    return true;
+}
+
+/*!
+ * \brief Copies the run of ASCII characters at \a input (which is the same in Latin-1 and UTF-8).
+ * \remarks Copies 16 characters at a time if SSE2 is available and 8 characters at a time otherwise.
+ */
+inline bool copyAsciiBlock(const unsigned char *&input, const unsigned char *inputEnd, unsigned char *&output, unsigned char *outputEnd)
+{
+    if (*input >= 0x80 || output == outputEnd) {
+        return false;
+    }
+#ifdef __SSE2__
+    while (inputEnd - input >= 16 && outputEnd - output >= 16) {
+        const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input));
+        if (_mm_movemask_epi8(chars)) {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(output), chars);
+        input += 16;
+        output += 16;
+    }
+#else
+    while (inputEnd - input >= 8 && outputEnd - output >= 8) {
+        auto chars = std::uint64_t();
+        std::memcpy(&chars, input, sizeof(chars));
+        if (chars & 0x8080808080808080u) {
+            break;
         }
-        return StringData(std::unique_ptr<char[], StringDataDeleter>(outputBuffer), currentOutputOffset - outputBuffer);
+        std::memcpy(output, &chars, sizeof(chars));
+        input += 8;
+        output += 8;
     }
+#endif
+    for (; input != inputEnd && *input < 0x80 && output != outputEnd;) {
+        *output++ = *input++;
+    }
+    return true;
+}
 
-private:
-    iconv_t m_ptr;
-    OutputSizeHint m_outputSizeHint;
+template <bool bigEndian> struct Utf8ToUtf16Encoding {
+    static constexpr auto maxCodePoint = char32_t(0x10FFFF);
+    static constexpr auto decode = decodeUtf8Sequence;
+    static constexpr auto encode = writeUtf16<bigEndian>;
+    static constexpr auto convertBlock = convertAsciiBlockToUtf16<bigEndian>;
 };
 
+template <bool bigEndian> struct Utf16ToUtf8Encoding {
+    static constexpr auto maxCodePoint = char32_t(0x10FFFF);
+    static constexpr auto decode = decodeUtf16Sequence<bigEndian>;
+    static constexpr auto encode = writeUtf8;
+    static constexpr auto convertBlock = convertAsciiBlockToUtf8<bigEndian>;
+};
+
+struct Latin1ToUtf8Encoding {
+    static constexpr auto maxCodePoint = char32_t(0x10FFFF);
+    static constexpr auto decode = decodeLatin1;
+    static constexpr auto encode = writeUtf8;
+    static constexpr auto convertBlock = copyAsciiBlock;
+};
+
+struct Utf8ToLatin1Encoding {
+    static constexpr auto maxCodePoint = char32_t(0xFF);
+    static constexpr auto decode = decodeUtf8Sequence;
+    static constexpr auto encode = writeLatin1;
+    static constexpr auto convertBlock = copyAsciiBlock;
+};
+
+/*!
+ * \brief Converts the whole input using \a Converter, throwing a ConversionException if it is invalid.
+ * \remarks An incomplete sequence at the end of the input is ignored (like iconv() does).
+ */
+template <class Converter> static StringData convertUnicodeString(Converter converter, const char *inputBuffer, std::size_t inputBufferSize)
+{
+    const auto outputSize = Converter::maxOutputSize(inputBufferSize);
+    auto output = StringData(std::unique_ptr<char[], StringDataDeleter>(reinterpret_cast<char *>(std::malloc(outputSize))), 0);
+    if (!output.first) {
+        throw std::bad_alloc();
+    }
+    const auto result = converter.convert(std::string_view(inputBuffer, inputBufferSize), output.first.get(), outputSize);
+    if (result.status != UnicodeConversionStatus::Ok) {
+        throw ConversionException("Invalid multibyte sequence in the input.");
+    }
+    output.second = result.bytesWritten;
+    return output;
+}
+
 /// \endcond
 
 /*!
- * \brief Converts the specified string from one character set to another.
+ * \class Utf8ToUtf16Converter
+ * \brief The Utf8ToUtf16Converter class converts UTF-8 to UTF-16 without iconv.
  * \remarks
- * - The term "size" refers here always to the actual number of bytes and not to the number of characters
- *   (eg. the size of the UTF-8 string "ö" is 2 and not 1).
- * - The expected size of the output buffer can be specified via \a outputBufferSizeFactor. This hint helps
- *   to reduce buffer reallocations during the conversion (eg. for the conversion from Latin-1 to UTF-16
- *   the factor would be 2, for the conversion from UTF-16 to Latin-1 the factor would be 0.5).
+ * - The input is validated. Overlong encodings, encoded surrogates and code points beyond U+10FFFF are rejected.
+ * - The output is written into a caller-provided buffer. Use maxOutputSize() to determine a sufficient buffer size
+ *   or call convert() again with the remaining input when UnicodeConversionStatus::OutputBufferTooSmall is returned.
+ * - The input can be passed in chunks of arbitrary size. A sequence split across chunks is completed with the
+ *   next chunk.
+ * - Runs of ASCII characters are converted 16 characters at a time if SSE2 is available.
  */
-StringData convertString(
-    const char *fromCharset, const char *toCharset, const char *inputBuffer, std::size_t inputBufferSize, float outputBufferSizeFactor)
+
+/*!
+ * \brief Converts the specified UTF-8 \a input to UTF-16 writing it to \a outputBuffer.
+ * \remarks If UnicodeConversionStatus::InvalidInput is returned, the invalid sequence starts at the returned number of
+ *          bytes read (or within the previous chunk if that is zero). The converter can be used for further input
+ *          after skipping it.
+ */
+UnicodeConversionResult Utf8ToUtf16Converter::convert(std::string_view input, char *outputBuffer, std::size_t outputBufferSize)
 {
-    return ConversionDescriptor<Factor>(fromCharset, toCharset, outputBufferSizeFactor).convertString(inputBuffer, inputBufferSize);
+    if (m_endianness == Utf16Endianness::BigEndian) {
+        return convertUnicode<Utf8ToUtf16Encoding<true>>(input, outputBuffer, outputBufferSize, m_pendingInput, m_pendingInputSize);
+    } else {
+        return convertUnicode<Utf8ToUtf16Encoding<false>>(input, outputBuffer, outputBufferSize, m_pendingInput, m_pendingInputSize);
+    }
+}
+
+/*!
+ * \class Utf16ToUtf8Converter
+ * \brief The Utf16ToUtf8Converter class converts UTF-16 to UTF-8 without iconv.
+ * \remarks
+ * - The input is validated. Unpaired surrogates are rejected.
+ * - The output is written into a caller-provided buffer. Use maxOutputSize() to determine a sufficient buffer size
+ *   or call convert() again with the remaining input when UnicodeConversionStatus::OutputBufferTooSmall is returned.
+ * - The input can be passed in chunks of arbitrary size (also odd sizes). A sequence split across chunks is completed
+ *   with the next chunk.
+ * - Runs of ASCII characters are converted 16 characters at a time if SSE2 is available.
+ * - A byte order mark is not treated specially. Use the endianness it indicates when constructing the converter and
+ *   skip it if it should not end up in the output.
+ */
+
+/*!
+ * \brief Converts the specified UTF-16 \a input to UTF-8 writing it to \a outputBuffer.
+ * \remarks If UnicodeConversionStatus::InvalidInput is returned, the invalid sequence starts at the returned number of
+ *          bytes read (or within the previous chunk if that is zero). The converter can be used for further input
+ *          after skipping it.
+ */
+UnicodeConversionResult Utf16ToUtf8Converter::convert(std::string_view input, char *outputBuffer, std::size_t outputBufferSize)
+{
+    if (m_endianness == Utf16Endianness::BigEndian) {
+        return convertUnicode<Utf16ToUtf8Encoding<true>>(input, outputBuffer, outputBufferSize, m_pendingInput, m_pendingInputSize);
+    } else {
+        return convertUnicode<Utf16ToUtf8Encoding<false>>(input, outputBuffer, outputBufferSize, m_pendingInput, m_pendingInputSize);
+    }
+}
+
+/*!
+ * \class Latin1ToUtf8Converter
+ * \brief The Latin1ToUtf8Converter class converts Latin-1 (ISO-8859-1) to UTF-8 without iconv.
+ * \remarks
+ * - Every byte is a valid Latin-1 character so the conversion can not fail.
+ * - The output is written into a caller-provided buffer. Use maxOutputSize() to determine a sufficient buffer size
+ *   or call convert() again with the remaining input when UnicodeConversionStatus::OutputBufferTooSmall is returned.
+ * - Runs of ASCII characters are copied 16 characters at a time if SSE2 is available (and 8 characters at a time
+ *   otherwise).
+ */
+
+/*!
+ * \brief Converts the specified Latin-1 \a input to UTF-8 writing it to \a outputBuffer.
+ */
+UnicodeConversionResult Latin1ToUtf8Converter::convert(std::string_view input, char *outputBuffer, std::size_t outputBufferSize)
+{
+    unsigned char pendingInput[3], pendingInputSize = 0;
+    return convertUnicode<Latin1ToUtf8Encoding>(input, outputBuffer, outputBufferSize, pendingInput, pendingInputSize);
+}
+
+/*!
+ * \class Utf8ToLatin1Converter
+ * \brief The Utf8ToLatin1Converter class converts UTF-8 to Latin-1 (ISO-8859-1) without iconv.
+ * \remarks
+ * - The input is validated like Utf8ToUtf16Converter does. Characters beyond U+00FF can not be represented in
+ *   Latin-1 and are treated as invalid input.
+ * - The output is written into a caller-provided buffer. Use maxOutputSize() to determine a sufficient buffer size
+ *   or call convert() again with the remaining input when UnicodeConversionStatus::OutputBufferTooSmall is returned.
+ * - The input can be passed in chunks of arbitrary size. A sequence split across chunks is completed with the
+ *   next chunk.
+ * - Runs of ASCII characters are copied 16 characters at a time if SSE2 is available (and 8 characters at a time
+ *   otherwise).
+ */
+
+/*!
+ * \brief Converts the specified UTF-8 \a input to Latin-1 writing it to \a outputBuffer.
+ * \remarks If UnicodeConversionStatus::InvalidInput is returned, the invalid (or unrepresentable) sequence starts at
+ *          the returned number of bytes read (or within the previous chunk if that is zero). The converter can be used
+ *          for further input after skipping it.
+ */
+UnicodeConversionResult Utf8ToLatin1Converter::convert(std::string_view input, char *outputBuffer, std::size_t outputBufferSize)
+{
+    return convertUnicode<Utf8ToLatin1Encoding>(input, outputBuffer, outputBufferSize, m_pendingInput, m_pendingInputSize);
 }
 
 /*!
  * \brief Converts the specified UTF-8 string to UTF-16 (little-endian).
+ * \throws Throws a ConversionException if the input is invalid.
+ * \sa Utf8ToUtf16Converter for converting into existing buffers or in chunks.
  */
 StringData convertUtf8ToUtf16LE(const char *inputBuffer, std::size_t inputBufferSize)
 {
-    CPP_UTILITIES_THREAD_LOCAL ConversionDescriptor<Double> descriptor("UTF-8", "UTF-16LE");
-    return descriptor.convertString(inputBuffer, inputBufferSize);
+    return convertUnicodeString(Utf8ToUtf16Converter(Utf16Endianness::LittleEndian), inputBuffer, inputBufferSize);
 }
 
 /*!
  * \brief Converts the specified UTF-16 (little-endian) string to UTF-8.
+ * \throws Throws a ConversionException if the input is invalid.
+ * \sa Utf16ToUtf8Converter for converting into existing buffers or in chunks.
  */
 StringData convertUtf16LEToUtf8(const char *inputBuffer, std::size_t inputBufferSize)
 {
-    CPP_UTILITIES_THREAD_LOCAL ConversionDescriptor<Half> descriptor("UTF-16LE", "UTF-8");
-    return descriptor.convertString(inputBuffer, inputBufferSize);
+    return convertUnicodeString(Utf16ToUtf8Converter(Utf16Endianness::LittleEndian), inputBuffer, inputBufferSize);
 }
 
 /*!
  * \brief Converts the specified UTF-8 string to UTF-16 (big-endian).
+ * \throws Throws a ConversionException if the input is invalid.
+ * \sa Utf8ToUtf16Converter for converting into existing buffers or in chunks.
  */
 StringData convertUtf8ToUtf16BE(const char *inputBuffer, std::size_t inputBufferSize)
 {
-    CPP_UTILITIES_THREAD_LOCAL ConversionDescriptor<Double> descriptor("UTF-8", "UTF-16BE");
-    return descriptor.convertString(inputBuffer, inputBufferSize);
+    return convertUnicodeString(Utf8ToUtf16Converter(Utf16Endianness::BigEndian), inputBuffer, inputBufferSize);
 }
 
 /*!
  * \brief Converts the specified UTF-16 (big-endian) string to UTF-8.
+ * \throws Throws a ConversionException if the input is invalid.
+ * \sa Utf16ToUtf8Converter for converting into existing buffers or in chunks.
  */
 StringData convertUtf16BEToUtf8(const char *inputBuffer, std::size_t inputBufferSize)
 {
-    CPP_UTILITIES_THREAD_LOCAL ConversionDescriptor<Half> descriptor("UTF-16BE", "UTF-8");
-    return descriptor.convertString(inputBuffer, inputBufferSize);
+    return convertUnicodeString(Utf16ToUtf8Converter(Utf16Endianness::BigEndian), inputBuffer, inputBufferSize);
 }
 
 /*!
  * \brief Converts the specified Latin-1 string to UTF-8.
+ * \sa Latin1ToUtf8Converter for converting into existing buffers.
  */
 StringData convertLatin1ToUtf8(const char *inputBuffer, std::size_t inputBufferSize)
 {
-    CPP_UTILITIES_THREAD_LOCAL ConversionDescriptor<Keep> descriptor("ISO-8859-1", "UTF-8");
-    return descriptor.convertString(inputBuffer, inputBufferSize);
+    return convertUnicodeString(Latin1ToUtf8Converter(), inputBuffer, inputBufferSize);
 }
 
 /*!
  * \brief Converts the specified UTF-8 string to Latin-1.
+ * \throws Throws a ConversionException if the input is invalid or contains characters not representable in Latin-1.
+ * \sa Utf8ToLatin1Converter for converting into existing buffers or in chunks.
  */
 StringData convertUtf8ToLatin1(const char *inputBuffer, std::size_t inputBufferSize)
 {
-    CPP_UTILITIES_THREAD_LOCAL ConversionDescriptor<Keep> descriptor("UTF-8", "ISO-8859-1");
-    return descriptor.convertString(inputBuffer, inputBufferSize);
+    return convertUnicodeString(Utf8ToLatin1Converter(), inputBuffer, inputBufferSize);
+}
+
+#ifndef CPP_UTILITIES_NO_ICONV
+
+/// \cond
+
+/*!
+ * \brief Converts the input using the specified iconv \a descriptor.
+ * \remarks
+ * - \a resize is called to (re)allocate the output buffer for at least the specified size; it might increase the specified
+ *   size to allocate more space upfront and returns a pointer to the (possibly moved) buffer.
+ * - An incomplete multibyte sequence at the end of the input is ignored.
+ * \returns Returns the number of bytes written.
+ */
+template <typename Resize>
+static std::size_t convertViaIconv(
+    iconv_t descriptor, const char *inputBuffer, std::size_t inputBufferSize, float outputBufferSizeFactor, Resize resize)
+{
+    const auto outputSizeHint = [outputBufferSizeFactor](std::size_t inputSize) {
+        return std::max<std::size_t>(static_cast<std::size_t>(static_cast<float>(inputSize) * outputBufferSizeFactor), 16);
+    };
+
+    // reset the conversion state which might be left over from a previous (failed) conversion
+    iconv(descriptor, nullptr, nullptr, nullptr, nullptr);
+
+    auto inputBytesLeft = inputBufferSize;
+    auto outputSize = outputSizeHint(inputBufferSize);
+    auto *outputBuffer = resize(outputSize);
+    auto bytesWritten = std::size_t();
+    for (;;) {
+        auto *currentOutputOffset = outputBuffer + bytesWritten;
+        auto outputBytesLeft = outputSize - bytesWritten;
+        const auto res = iconv(descriptor, const_cast<char **>(&inputBuffer), &inputBytesLeft, &currentOutputOffset, &outputBytesLeft);
+        bytesWritten = static_cast<std::size_t>(currentOutputOffset - outputBuffer);
+        if (res != static_cast<std::size_t>(-1) || errno == EINVAL) {
+            // conversion completed without (further) errors or incomplete multibyte sequence at the end of the input
+            return bytesWritten;
+        } else if (errno == E2BIG) {
+            // output buffer has no more room for next converted character
+            outputSize += outputSizeHint(inputBytesLeft);
+            outputBuffer = resize(outputSize);
+        } else /*if(errno == EILSEQ)*/ {
+            // invalid multibyte sequence in the input
+            throw ConversionException("Invalid multibyte sequence in the input.");
+        }
+    }
+}
+
+#ifndef CPP_UTILITIES_NO_STRING_CONVERTER_CACHE
+/*!
+ * \brief The CachedStringConverter struct is an entry of the cache used by convertString().
+ */
+struct CachedStringConverter {
+    std::string fromCharset;
+    std::string toCharset;
+    StringConverter converter;
+};
+
+/*!
+ * \brief Returns a StringConverter for the specified charsets from the (thread-local) cache.
+ * \remarks The cache is only valid until the next call.
+ */
+static StringConverter &cachedStringConverter(const char *fromCharset, const char *toCharset)
+{
+    constexpr auto maxCacheSize = std::size_t(16);
+    CPP_UTILITIES_THREAD_LOCAL std::vector<CachedStringConverter> cache;
+    for (auto &entry : cache) {
+        if (entry.fromCharset == fromCharset && entry.toCharset == toCharset) {
+            return entry.converter;
+        }
+    }
+    if (cache.size() >= maxCacheSize) {
+        cache.erase(cache.begin());
+    }
+    return cache.emplace_back(CachedStringConverter{ fromCharset, toCharset, StringConverter(fromCharset, toCharset) }).converter;
+}
+#endif
+
+/// \endcond
+
+/*!
+ * \class StringConverter
+ * \brief The StringConverter class converts strings from one character set to another using iconv.
+ * \remarks
+ * - The underlying iconv descriptor is opened once when constructing the converter and can be used for any number
+ *   of conversions. So prefer this class over convertString() when converting many strings.
+ * - An instance must not be used by multiple threads at the same time.
+ * - See convertString() for details about the conversion itself.
+ */
+
+/*!
+ * \brief Constructs a new converter for converting from \a fromCharset to \a toCharset.
+ * \throws Throws a ConversionException if the conversion is not supported.
+ */
+StringConverter::StringConverter(const char *fromCharset, const char *toCharset, float outputBufferSizeFactor)
+    : m_descriptor(iconv_open(toCharset, fromCharset))
+    , m_outputBufferSizeFactor(outputBufferSizeFactor)
+{
+    static_assert(sizeof(iconv_t) == sizeof(void *), "iconv_t can be stored as void *");
+    if (static_cast<iconv_t>(m_descriptor) == reinterpret_cast<iconv_t>(-1)) {
+        throw ConversionException("Unable to allocate descriptor for character set conversion.");
+    }
+}
+
+/*!
+ * \brief Constructs a new converter taking over the descriptor of \a other.
+ */
+StringConverter::StringConverter(StringConverter &&other) noexcept
+    : m_descriptor(other.m_descriptor)
+    , m_outputBufferSizeFactor(other.m_outputBufferSizeFactor)
+{
+    other.m_descriptor = nullptr;
+}
+
+/*!
+ * \brief Closes the underlying descriptor.
+ */
+StringConverter::~StringConverter()
+{
+    if (m_descriptor) {
+        iconv_close(static_cast<iconv_t>(m_descriptor));
+    }
+}
+
+/*!
+ * \brief Closes the underlying descriptor and takes over the descriptor of \a other.
+ */
+StringConverter &StringConverter::operator=(StringConverter &&other) noexcept
+{
+    if (this != &other) {
+        if (m_descriptor) {
+            iconv_close(static_cast<iconv_t>(m_descriptor));
+        }
+        m_descriptor = other.m_descriptor;
+        m_outputBufferSizeFactor = other.m_outputBufferSizeFactor;
+        other.m_descriptor = nullptr;
+    }
+    return *this;
+}
+
+/*!
+ * \brief Converts the specified input returning a newly allocated buffer.
+ * \throws Throws a ConversionException if the input contains an invalid multibyte sequence.
+ */
+StringData StringConverter::convert(const char *inputBuffer, std::size_t inputBufferSize)
+{
+    auto output = StringData();
+    output.second = convertViaIconv(static_cast<iconv_t>(m_descriptor), inputBuffer, inputBufferSize, m_outputBufferSizeFactor,
+        [&output](std::size_t &size) {
+            auto *const buffer = static_cast<char *>(std::realloc(output.first.get(), size));
+            if (!buffer) {
+                throw std::bad_alloc();
+            }
+            output.first.release();
+            output.first.reset(buffer);
+            return buffer;
+        });
+    return output;
+}
+
+/*!
+ * \brief Converts the specified \a input storing the result in \a output.
+ * \remarks The previous contents of \a output are replaced. Its capacity is reused so converting many strings into
+ *          the same \a output avoids allocations.
+ * \throws Throws a ConversionException if the input contains an invalid multibyte sequence.
+ */
+void StringConverter::convert(std::string_view input, std::string &output)
+{
+    output.resize(convertViaIconv(static_cast<iconv_t>(m_descriptor), input.data(), input.size(), m_outputBufferSizeFactor,
+        [&output, isFirstCall = true](std::size_t &size) mutable {
+            // grow geometrically when running out of space; resize() only zero-fills the part exceeding the previous size
+            if (!std::exchange(isFirstCall, false)) {
+                size = std::max(size, output.size() * 2);
+            }
+            output.resize(size);
+            return output.data();
+        }));
+}
+
+/*!
+ * \brief Converts the specified string from one character set to another.
+ * \remarks
+ * - The term "size" refers here always to the actual number of bytes and not to the number of characters
+ *   (eg. the size of the UTF-8 string "ö" is 2 and not 1).
+ * - The expected size of the output buffer can be specified via \a outputBufferSizeFactor. This hint helps
+ *   to reduce buffer reallocations during the conversion (eg. for the conversion from Latin-1 to UTF-16
+ *   the factor would be 2, for the conversion from UTF-16 to Latin-1 the factor would be 0.5).
+ * - The iconv descriptors of recently used charset pairs are cached per thread so repeated conversions
+ *   between the same charsets don't need to open a new descriptor. Use StringConverter to control the
+ *   lifetime of the descriptor explicitly. If thread-local storage is disabled (ENABLE_THREAD_LOCAL=OFF)
+ *   or unavailable, no descriptors are cached.
+ */
+StringData convertString(
+    const char *fromCharset, const char *toCharset, const char *inputBuffer, std::size_t inputBufferSize, float outputBufferSizeFactor)
+{
+#ifndef CPP_UTILITIES_NO_STRING_CONVERTER_CACHE
+    auto &converter = cachedStringConverter(fromCharset, toCharset);
+    converter.setOutputBufferSizeFactor(outputBufferSizeFactor);
+#else
+    // a cache shared between threads would need locking; so just open a new descriptor if thread-local storage is not available
+    auto converter = StringConverter(fromCharset, toCharset, outputBufferSizeFactor);
+#endif
+    return converter.convert(inputBuffer, inputBufferSize);
 }
 
 #endif
@@ -378,47 +974,272 @@ string bitrateToString(double bitrateInKbitsPerSecond, bool useIecBinaryPrefixes
 //! \cond
 const char *const base64Chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 const char base64Pad = '=';
+
+/*!
+ * \brief Maps each 12-bit value to the two corresponding Base64 characters so 3 bytes can be encoded via 2 lookups.
+ */
+static constexpr auto base64EncodeTable = [] {
+    auto table = std::array<char, 4096 * 2>();
+    for (auto i = std::size_t(); i != 4096; ++i) {
+        table[i * 2] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[i >> 6];
+        table[i * 2 + 1] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[i & 0x3F];
+    }
+    return table;
+}();
+
+/*!
+ * \brief Maps each character to its 6-bit value shifted to the position within a quantum of 4 characters.
+ * \remarks Characters which are not part of the Base64 alphabet are mapped to base64InvalidValue so 4 characters
+ *          can be decoded via 4 lookups and a single check.
+ */
+constexpr auto base64InvalidValue = std::uint32_t(0x01000000);
+static constexpr auto base64DecodeTables = [] {
+    auto tables = std::array<std::array<std::uint32_t, 256>, 4>();
+    for (auto &table : tables) {
+        for (auto &value : table) {
+            value = base64InvalidValue;
+        }
+    }
+    for (auto i = std::uint32_t(); i != 64; ++i) {
+        const auto c = static_cast<unsigned char>("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[i]);
+        tables[0][c] = i << 18;
+        tables[1][c] = i << 12;
+        tables[2][c] = i << 6;
+        tables[3][c] = i;
+    }
+    return tables;
+}();
+
+/*!
+ * \brief Encodes the specified number of \a blocks of 3 bytes from \a data to \a output.
+ */
+static char *encodeBase64Blocks(const std::uint8_t *data, std::size_t blocks, char *output)
+{
+#ifdef __SSSE3__
+    // encode 12 bytes to 16 characters at a time (as long as 16 bytes can be read)
+    for (; blocks >= 6; blocks -= 4, data += 12, output += 16) {
+        auto in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+        in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+        const auto t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+        const auto t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+        const auto indices = _mm_or_si128(t0, t1);
+        auto offsetIndices = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        offsetIndices = _mm_or_si128(offsetIndices, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+        const auto offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(output), _mm_add_epi8(_mm_shuffle_epi8(offsets, offsetIndices), indices));
+    }
+#endif
+    for (const auto *const end = data + blocks * 3; data != end; data += 3, output += 4) {
+        const auto value = static_cast<std::uint32_t>((data[0] << 16) | (data[1] << 8) | data[2]);
+        std::memcpy(output, base64EncodeTable.data() + (value >> 12) * 2, 2);
+        std::memcpy(output + 2, base64EncodeTable.data() + (value & 0xFFF) * 2, 2);
+    }
+    return output;
+}
+
+/*!
+ * \brief Decodes as many quanta of 4 characters from \a encodedStr to \a output as possible.
+ * \remarks Stops at the first quantum containing a character which is not part of the Base64 alphabet (e.g.
+ *          whitespace or padding); that quantum is left for the caller to process character by character.
+ */
+static void decodeBase64Quanta(const char *&encodedStr, const char *end, std::uint8_t *&output)
+{
+#ifdef __SSSE3__
+    // decode 16 characters to 12 bytes at a time (as long as 16 bytes can be written; 24 characters give at least 18 bytes)
+    for (; end - encodedStr >= 24; encodedStr += 16, output += 12) {
+        const auto in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(encodedStr));
+        const auto highNibbles = _mm_and_si128(_mm_srli_epi32(in, 4), _mm_set1_epi8(0x0F));
+        const auto lowNibbles = _mm_and_si128(in, _mm_set1_epi8(0x0F));
+        const auto lowBits = _mm_shuffle_epi8(
+            _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A), lowNibbles);
+        const auto highBits = _mm_shuffle_epi8(
+            _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10), highNibbles);
+        if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lowBits, highBits), _mm_setzero_si128()))) {
+            break;
+        }
+        const auto offsets = _mm_shuffle_epi8(_mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0),
+            _mm_add_epi8(_mm_cmpeq_epi8(in, _mm_set1_epi8('/')), highNibbles));
+        const auto values = _mm_add_epi8(in, offsets);
+        const auto merged = _mm_madd_epi16(_mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(output),
+            _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)));
+    }
+#endif
+    for (; end - encodedStr >= 4; encodedStr += 4, output += 3) {
+        const auto *const chars = reinterpret_cast<const unsigned char *>(encodedStr);
+        const auto value = base64DecodeTables[0][chars[0]] | base64DecodeTables[1][chars[1]] | base64DecodeTables[2][chars[2]]
+            | base64DecodeTables[3][chars[3]];
+        if (value & base64InvalidValue) {
+            break;
+        }
+        output[0] = static_cast<std::uint8_t>(value >> 16);
+        output[1] = static_cast<std::uint8_t>(value >> 8);
+        output[2] = static_cast<std::uint8_t>(value);
+    }
+}
 //! \endcond
 
+/*!
+ * \class Base64Encoder
+ * \brief The Base64Encoder class encodes data to Base64 in chunks writing into caller-provided buffers.
+ * \remarks
+ * - Call encode() for each chunk and finish() after the last chunk to write the remaining characters and padding.
+ * - Chunks of any size can be passed; bytes not forming a complete block of 3 bytes are kept for the next call.
+ * - Blocks of 12 bytes are encoded at a time if SSSE3 is available. Otherwise 3 bytes are encoded via two lookups
+ *   in a table of character pairs.
+ * \sa [RFC 4648](http://www.ietf.org/rfc/rfc4648.txt)
+ */
+
+/*!
+ * \brief Encodes the specified \a data writing the characters to \a output.
+ * \returns Returns the number of characters written (at most maxOutputSize(\a dataSize)).
+ */
+std::size_t Base64Encoder::encode(const std::uint8_t *data, std::size_t dataSize, char *output)
+{
+    auto *out = output;
+    if (m_pendingDataSize) {
+        std::uint8_t block[3];
+        const auto takenSize = std::min<std::size_t>(3u - m_pendingDataSize, dataSize);
+        std::memcpy(block, m_pendingData, m_pendingDataSize);
+        std::memcpy(block + m_pendingDataSize, data, takenSize);
+        if (m_pendingDataSize + takenSize < 3) {
+            std::memcpy(m_pendingData, block, m_pendingDataSize += static_cast<std::uint8_t>(takenSize));
+            return 0;
+        }
+        out = encodeBase64Blocks(block, 1, out);
+        data += takenSize;
+        dataSize -= takenSize;
+    }
+    const auto blocks = dataSize / 3;
+    out = encodeBase64Blocks(data, blocks, out);
+    m_pendingDataSize = static_cast<std::uint8_t>(dataSize - blocks * 3);
+    std::memcpy(m_pendingData, data + blocks * 3, m_pendingDataSize);
+    return static_cast<std::size_t>(out - output);
+}
+
+/*!
+ * \brief Writes the remaining characters including padding to \a output.
+ * \returns Returns the number of characters written (at most 4).
+ * \remarks The encoder can be used to encode further data afterwards.
+ */
+std::size_t Base64Encoder::finish(char *output)
+{
+    if (!m_pendingDataSize) {
+        return 0;
+    }
+    const auto value = static_cast<std::uint32_t>((m_pendingData[0] << 16) | (m_pendingDataSize == 2 ? m_pendingData[1] << 8 : 0));
+    output[0] = base64Chars[(value >> 18) & 0x3F];
+    output[1] = base64Chars[(value >> 12) & 0x3F];
+    output[2] = m_pendingDataSize == 2 ? base64Chars[(value >> 6) & 0x3F] : base64Pad;
+    output[3] = base64Pad;
+    m_pendingDataSize = 0;
+    return 4;
+}
+
+/*!
+ * \class Base64Decoder
+ * \brief The Base64Decoder class decodes Base64 in chunks writing into caller-provided buffers.
+ * \remarks
+ * - Call decode() for each chunk and finish() after the last chunk to check whether the input was complete.
+ * - Chunks of any size can be passed; characters not forming a complete quantum of 4 characters are kept for
+ *   the next call.
+ * - Padding is required (like decodeBase64() always did). Whitespace is only accepted if
+ *   Base64DecodeOptions::SkipWhitespace is specified.
+ * - Quanta of 16 characters are decoded at a time if SSSE3 is available. Otherwise 4 characters are decoded via
+ *   four table lookups. Quanta containing whitespace or padding are decoded character by character.
+ * \sa [RFC 4648](http://www.ietf.org/rfc/rfc4648.txt)
+ */
+
+/*!
+ * \brief Decodes the specified \a encodedStr writing the bytes to \a output.
+ * \returns Returns the number of bytes written (at most maxOutputSize(\a strSize)).
+ * \throws Throws a ConversionException if \a encodedStr contains an invalid character or invalid padding.
+ */
+std::size_t Base64Decoder::decode(const char *encodedStr, std::size_t strSize, std::uint8_t *output)
+{
+    const auto *const end = encodedStr + strSize;
+    auto *out = output;
+    const auto skipWhitespace = m_options && Base64DecodeOptions::SkipWhitespace;
+    while (encodedStr != end) {
+        if (!m_pendingValueCount && !m_paddingSize) {
+            decodeBase64Quanta(encodedStr, end, out);
+            if (encodedStr == end) {
+                break;
+            }
+        }
+        const auto c = *encodedStr++;
+        if (skipWhitespace && (c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f')) {
+            continue;
+        }
+        if (c == base64Pad) {
+            if (m_pendingValueCount < 2 || m_pendingValueCount + m_paddingSize >= 4) {
+                throw ConversionException("invalid padding in base64");
+            }
+            if (!m_paddingSize++) {
+                *out++ = static_cast<std::uint8_t>((m_pendingValues[0] << 2) | (m_pendingValues[1] >> 4));
+                if (m_pendingValueCount == 3) {
+                    *out++ = static_cast<std::uint8_t>((m_pendingValues[1] << 4) | (m_pendingValues[2] >> 2));
+                }
+            }
+            continue;
+        }
+        const auto value = base64DecodeTables[3][static_cast<unsigned char>(c)];
+        if (value & base64InvalidValue) {
+            throw ConversionException("invalid character in base64");
+        }
+        if (m_paddingSize) {
+            throw ConversionException("invalid padding in base64");
+        }
+        if (m_pendingValueCount < 3) {
+            m_pendingValues[m_pendingValueCount++] = static_cast<std::uint8_t>(value);
+            continue;
+        }
+        *out++ = static_cast<std::uint8_t>((m_pendingValues[0] << 2) | (m_pendingValues[1] >> 4));
+        *out++ = static_cast<std::uint8_t>((m_pendingValues[1] << 4) | (m_pendingValues[2] >> 2));
+        *out++ = static_cast<std::uint8_t>((m_pendingValues[2] << 6) | value);
+        m_pendingValueCount = 0;
+    }
+    return static_cast<std::size_t>(out - output);
+}
+
+/*!
+ * \brief Checks whether the input passed to decode() so far ends with a complete quantum.
+ * \throws Throws a ConversionException if the input is incomplete (e.g. padding is missing).
+ * \remarks The decoder is reset so it can be used to decode further input afterwards.
+ */
+void Base64Decoder::finish()
+{
+    const auto quantumSize = m_pendingValueCount + m_paddingSize;
+    m_pendingValueCount = m_paddingSize = 0;
+    if (quantumSize && quantumSize != 4) {
+        throw ConversionException("invalid size of base64");
+    }
+}
+
 /*!
  * \brief Encodes the specified \a data to Base64.
  * \sa [RFC 4648](http://www.ietf.org/rfc/rfc4648.txt)
  */
 string encodeBase64(const std::uint8_t *data, std::uint32_t dataSize)
 {
-    auto encoded = std::string();
-    auto mod = static_cast<std::uint8_t>(dataSize % 3);
-    auto temp = std::uint32_t();
-    encoded.reserve(((dataSize / 3) + (mod > 0)) * 4);
-    for (const std::uint8_t *end = --data + dataSize - mod; data != end;) {
-        temp = static_cast<std::uint32_t>(*++data << 16);
-        temp |= static_cast<std::uint32_t>(*++data << 8);
-        temp |= *++data;
-        encoded.push_back(base64Chars[(temp & 0x00FC0000) >> 18]);
-        encoded.push_back(base64Chars[(temp & 0x0003F000) >> 12]);
-        encoded.push_back(base64Chars[(temp & 0x00000FC0) >> 6]);
-        encoded.push_back(base64Chars[(temp & 0x0000003F)]);
-    }
-    switch (mod) {
-    case 1:
-        temp = static_cast<std::uint32_t>(*++data << 16);
-        encoded.push_back(base64Chars[(temp & 0x00FC0000) >> 18]);
-        encoded.push_back(base64Chars[(temp & 0x0003F000) >> 12]);
-        encoded.push_back(base64Pad);
-        encoded.push_back(base64Pad);
-        break;
-    case 2:
-        temp = static_cast<std::uint32_t>(*++data << 16);
-        temp |= static_cast<std::uint32_t>(*++data << 8);
-        encoded.push_back(base64Chars[(temp & 0x00FC0000) >> 18]);
-        encoded.push_back(base64Chars[(temp & 0x0003F000) >> 12]);
-        encoded.push_back(base64Chars[(temp & 0x00000FC0) >> 6]);
-        encoded.push_back(base64Pad);
-        break;
-    }
+    auto encoded = std::string(Base64Encoder::maxOutputSize(dataSize), '\0');
+    encodeBase64(data, dataSize, encoded.data());
     return encoded;
 }
 
+/*!
+ * \brief Encodes the specified \a data to Base64 writing the characters to \a output.
+ * \returns Returns the number of characters written which is always Base64Encoder::maxOutputSize(\a dataSize).
+ * \sa Base64Encoder for encoding in chunks.
+ */
+std::size_t encodeBase64(const std::uint8_t *data, std::size_t dataSize, char *output)
+{
+    auto encoder = Base64Encoder();
+    const auto size = encoder.encode(data, dataSize, output);
+    return size + encoder.finish(output + size);
+}
+
 /*!
  * \brief Decodes the specified Base64 encoded string.
  * \throw Throws a ConversionException if the specified string is no valid Base64.
@@ -426,56 +1247,22 @@ string encodeBase64(const std::uint8_t *data, std::uint32_t dataSize)
  */
 std::pair<std::unique_ptr<std::uint8_t[]>, std::uint32_t> decodeBase64(const char *encodedStr, const std::uint32_t strSize)
 {
-    if (!strSize) {
-        return std::make_pair(std::make_unique<std::uint8_t[]>(0), 0); // early return to prevent clazy warning
-    }
-    if (strSize % 4) {
-        throw ConversionException("invalid size of base64");
-    }
-    std::uint32_t decodedSize = (strSize / 4) * 3;
-    const char *const end = encodedStr + strSize;
-    if (*(end - 1) == base64Pad) {
-        --decodedSize;
-    }
-    if (*(end - 2) == base64Pad) {
-        --decodedSize;
-    }
-    auto buffer = std::make_unique<std::uint8_t[]>(decodedSize);
-    auto *iter = buffer.get() - 1;
-    while (encodedStr < end) {
-        std::int32_t temp = 0;
-        for (std::uint8_t quantumPos = 0; quantumPos < 4; ++quantumPos, ++encodedStr) {
-            temp <<= 6;
-            if (*encodedStr >= 'A' && *encodedStr <= 'Z') {
-                temp |= *encodedStr - 'A';
-            } else if (*encodedStr >= 'a' && *encodedStr <= 'z') {
-                temp |= *encodedStr - 'a' + 26;
-            } else if (*encodedStr >= '0' && *encodedStr <= '9') {
-                temp |= *encodedStr - '0' + 2 * 26;
-            } else if (*encodedStr == '+') {
-                temp |= 2 * 26 + 10;
-            } else if (*encodedStr == '/') {
-                temp |= 2 * 26 + 10 + 1;
-            } else if (*encodedStr == base64Pad) {
-                switch (end - encodedStr) {
-                case 1:
-                    *++iter = static_cast<std::uint8_t>((temp >> 16) & 0xFF);
-                    *++iter = static_cast<std::uint8_t>((temp >> 8) & 0xFF);
-                    return std::make_pair(std::move(buffer), decodedSize);
-                case 2:
-                    *++iter = static_cast<std::uint8_t>((temp >> 10) & 0xFF);
-                    return std::make_pair(std::move(buffer), decodedSize);
-                default:
-                    throw ConversionException("invalid padding in base64");
-                }
-            } else {
-                throw ConversionException("invalid character in base64");
-            }
-        }
-        *++iter = static_cast<std::uint8_t>((temp >> 16) & 0xFF);
-        *++iter = static_cast<std::uint8_t>((temp >> 8) & 0xFF);
-        *++iter = static_cast<std::uint8_t>(temp & 0xFF);
-    }
-    return std::make_pair(std::move(buffer), decodedSize);
+    auto buffer = std::make_unique<std::uint8_t[]>(Base64Decoder::maxOutputSize(strSize));
+    const auto decodedSize = decodeBase64(encodedStr, strSize, buffer.get());
+    return std::make_pair(std::move(buffer), static_cast<std::uint32_t>(decodedSize));
+}
+
+/*!
+ * \brief Decodes the specified Base64 encoded string writing the bytes to \a output.
+ * \returns Returns the number of bytes written (at most Base64Decoder::maxOutputSize(\a strSize)).
+ * \throw Throws a ConversionException if the specified string is no valid Base64.
+ * \sa Base64Decoder for decoding in chunks.
+ */
+std::size_t decodeBase64(const char *encodedStr, std::size_t strSize, std::uint8_t *output, Base64DecodeOptions options)
+{
+    auto decoder = Base64Decoder(options);
+    const auto size = decoder.decode(encodedStr, strSize, output);
+    decoder.finish();
+    return size;
 }
 } // namespace CppUtilities
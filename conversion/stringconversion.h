@@ -4,12 +4,16 @@
 #include "./binaryconversion.h"
 #include "./conversionexception.h"
 
+#include "../misc/flagenumclass.h"
 #include "../misc/traits.h"
 
+#include <charconv>
 #include <cstdlib>
 #include <cstring>
 #include <initializer_list>
 #include <iomanip>
+#include <iterator>
+#include <limits>
 #include <list>
 #include <memory>
 #include <sstream>
@@ -57,15 +61,255 @@ struct CPP_UTILITIES_EXPORT StringDataDeleter{ /*!
 using StringData = std::pair<std::unique_ptr<char[], StringDataDeleter>, std::size_t>;
 //using StringData = std::pair<std::unique_ptr<char>, std::size_t>; // might work too
 
-#ifndef CPP_UTILITIES_NO_ICONV
-CPP_UTILITIES_EXPORT StringData convertString(
-    const char *fromCharset, const char *toCharset, const char *inputBuffer, std::size_t inputBufferSize, float outputBufferSizeFactor = 1.0f);
+/*!
+ * \brief Specifies the byte order of UTF-16 encoded data.
+ */
+enum class Utf16Endianness {
+    LittleEndian, /**< UTF-16LE */
+    BigEndian, /**< UTF-16BE */
+};
+
+/*!
+ * \brief Specifies the outcome of Utf8ToUtf16Converter::convert() and Utf16ToUtf8Converter::convert().
+ */
+enum class UnicodeConversionStatus {
+    Ok, /**< all input has been consumed (an incomplete sequence at the end is kept for the next call) */
+    OutputBufferTooSmall, /**< the output buffer is full; the remaining input needs to be passed again */
+    InvalidInput, /**< the input contains an invalid sequence (starting at UnicodeConversionResult::bytesRead) */
+};
+
+/*!
+ * \brief The UnicodeConversionResult struct is returned by Utf8ToUtf16Converter::convert() and Utf16ToUtf8Converter::convert().
+ */
+struct CPP_UTILITIES_EXPORT UnicodeConversionResult {
+    std::size_t bytesRead = 0; /**< number of input bytes consumed (including bytes of an incomplete sequence kept for the next call) */
+    std::size_t bytesWritten = 0; /**< number of bytes written to the output buffer */
+    UnicodeConversionStatus status = UnicodeConversionStatus::Ok; /**< whether the input has been consumed completely */
+};
+
+class CPP_UTILITIES_EXPORT Utf8ToUtf16Converter {
+public:
+    explicit Utf8ToUtf16Converter(Utf16Endianness endianness = Utf16Endianness::LittleEndian);
+
+    Utf16Endianness endianness() const;
+    UnicodeConversionResult convert(std::string_view input, char *outputBuffer, std::size_t outputBufferSize);
+    bool hasPendingInput() const;
+    void reset();
+    static constexpr std::size_t maxOutputSize(std::size_t inputSize);
+
+private:
+    unsigned char m_pendingInput[3];
+    unsigned char m_pendingInputSize;
+    Utf16Endianness m_endianness;
+};
+
+/*!
+ * \brief Constructs a new converter producing UTF-16 with the specified \a endianness.
+ */
+inline Utf8ToUtf16Converter::Utf8ToUtf16Converter(Utf16Endianness endianness)
+    : m_pendingInput{}
+    , m_pendingInputSize(0)
+    , m_endianness(endianness)
+{
+}
+
+/*!
+ * \brief Returns the byte order of the produced UTF-16.
+ */
+inline Utf16Endianness Utf8ToUtf16Converter::endianness() const
+{
+    return m_endianness;
+}
+
+/*!
+ * \brief Returns whether an incomplete sequence at the end of the previous input is awaiting the next chunk.
+ */
+inline bool Utf8ToUtf16Converter::hasPendingInput() const
+{
+    return m_pendingInputSize;
+}
+
+/*!
+ * \brief Discards a pending incomplete sequence so the converter can be used for unrelated input.
+ */
+inline void Utf8ToUtf16Converter::reset()
+{
+    m_pendingInputSize = 0;
+}
+
+/*!
+ * \brief Returns the output buffer size (in bytes) which is always sufficient to convert \a inputSize bytes in one call.
+ */
+constexpr std::size_t Utf8ToUtf16Converter::maxOutputSize(std::size_t inputSize)
+{
+    return (inputSize + 3) * 2;
+}
+
+class CPP_UTILITIES_EXPORT Utf16ToUtf8Converter {
+public:
+    explicit Utf16ToUtf8Converter(Utf16Endianness endianness = Utf16Endianness::LittleEndian);
+
+    Utf16Endianness endianness() const;
+    UnicodeConversionResult convert(std::string_view input, char *outputBuffer, std::size_t outputBufferSize);
+    bool hasPendingInput() const;
+    void reset();
+    static constexpr std::size_t maxOutputSize(std::size_t inputSize);
+
+private:
+    unsigned char m_pendingInput[3];
+    unsigned char m_pendingInputSize;
+    Utf16Endianness m_endianness;
+};
+
+/*!
+ * \brief Constructs a new converter consuming UTF-16 with the specified \a endianness.
+ */
+inline Utf16ToUtf8Converter::Utf16ToUtf8Converter(Utf16Endianness endianness)
+    : m_pendingInput{}
+    , m_pendingInputSize(0)
+    , m_endianness(endianness)
+{
+}
+
+/*!
+ * \brief Returns the byte order of the consumed UTF-16.
+ */
+inline Utf16Endianness Utf16ToUtf8Converter::endianness() const
+{
+    return m_endianness;
+}
+
+/*!
+ * \brief Returns whether an incomplete sequence at the end of the previous input is awaiting the next chunk.
+ */
+inline bool Utf16ToUtf8Converter::hasPendingInput() const
+{
+    return m_pendingInputSize;
+}
+
+/*!
+ * \brief Discards a pending incomplete sequence so the converter can be used for unrelated input.
+ */
+inline void Utf16ToUtf8Converter::reset()
+{
+    m_pendingInputSize = 0;
+}
+
+/*!
+ * \brief Returns the output buffer size (in bytes) which is always sufficient to convert \a inputSize bytes in one call.
+ */
+constexpr std::size_t Utf16ToUtf8Converter::maxOutputSize(std::size_t inputSize)
+{
+    return (inputSize + 3) / 2 * 3;
+}
+
+class CPP_UTILITIES_EXPORT Latin1ToUtf8Converter {
+public:
+    UnicodeConversionResult convert(std::string_view input, char *outputBuffer, std::size_t outputBufferSize);
+    static constexpr std::size_t maxOutputSize(std::size_t inputSize);
+};
+
+/*!
+ * \brief Returns the output buffer size (in bytes) which is always sufficient to convert \a inputSize bytes in one call.
+ */
+constexpr std::size_t Latin1ToUtf8Converter::maxOutputSize(std::size_t inputSize)
+{
+    return inputSize * 2;
+}
+
+class CPP_UTILITIES_EXPORT Utf8ToLatin1Converter {
+public:
+    Utf8ToLatin1Converter();
+
+    UnicodeConversionResult convert(std::string_view input, char *outputBuffer, std::size_t outputBufferSize);
+    bool hasPendingInput() const;
+    void reset();
+    static constexpr std::size_t maxOutputSize(std::size_t inputSize);
+
+private:
+    unsigned char m_pendingInput[3];
+    unsigned char m_pendingInputSize;
+};
+
+/*!
+ * \brief Constructs a new converter.
+ */
+inline Utf8ToLatin1Converter::Utf8ToLatin1Converter()
+    : m_pendingInput{}
+    , m_pendingInputSize(0)
+{
+}
+
+/*!
+ * \brief Returns whether an incomplete sequence at the end of the previous input is awaiting the next chunk.
+ */
+inline bool Utf8ToLatin1Converter::hasPendingInput() const
+{
+    return m_pendingInputSize;
+}
+
+/*!
+ * \brief Discards a pending incomplete sequence so the converter can be used for unrelated input.
+ */
+inline void Utf8ToLatin1Converter::reset()
+{
+    m_pendingInputSize = 0;
+}
+
+/*!
+ * \brief Returns the output buffer size (in bytes) which is always sufficient to convert \a inputSize bytes in one call.
+ */
+constexpr std::size_t Utf8ToLatin1Converter::maxOutputSize(std::size_t inputSize)
+{
+    return inputSize + 1;
+}
+
 CPP_UTILITIES_EXPORT StringData convertUtf8ToUtf16LE(const char *inputBuffer, std::size_t inputBufferSize);
 CPP_UTILITIES_EXPORT StringData convertUtf16LEToUtf8(const char *inputBuffer, std::size_t inputBufferSize);
 CPP_UTILITIES_EXPORT StringData convertUtf8ToUtf16BE(const char *inputBuffer, std::size_t inputBufferSize);
 CPP_UTILITIES_EXPORT StringData convertUtf16BEToUtf8(const char *inputBuffer, std::size_t inputBufferSize);
 CPP_UTILITIES_EXPORT StringData convertLatin1ToUtf8(const char *inputBuffer, std::size_t inputBufferSize);
 CPP_UTILITIES_EXPORT StringData convertUtf8ToLatin1(const char *inputBuffer, std::size_t inputBufferSize);
+
+#ifndef CPP_UTILITIES_NO_ICONV
+class CPP_UTILITIES_EXPORT StringConverter {
+public:
+    explicit StringConverter(const char *fromCharset, const char *toCharset, float outputBufferSizeFactor = 1.0f);
+    StringConverter(const StringConverter &) = delete;
+    StringConverter(StringConverter &&other) noexcept;
+    ~StringConverter();
+    StringConverter &operator=(const StringConverter &) = delete;
+    StringConverter &operator=(StringConverter &&other) noexcept;
+
+    float outputBufferSizeFactor() const;
+    void setOutputBufferSizeFactor(float outputBufferSizeFactor);
+    StringData convert(const char *inputBuffer, std::size_t inputBufferSize);
+    void convert(std::string_view input, std::string &output);
+
+private:
+    void *m_descriptor;
+    float m_outputBufferSizeFactor;
+};
+
+/*!
+ * \brief Returns the factor used to determine the initial output buffer size from the input size.
+ */
+inline float StringConverter::outputBufferSizeFactor() const
+{
+    return m_outputBufferSizeFactor;
+}
+
+/*!
+ * \brief Sets the factor used to determine the initial output buffer size from the input size.
+ * \sa convertString() for details.
+ */
+inline void StringConverter::setOutputBufferSizeFactor(float outputBufferSizeFactor)
+{
+    m_outputBufferSizeFactor = outputBufferSizeFactor;
+}
+
+CPP_UTILITIES_EXPORT StringData convertString(
+    const char *fromCharset, const char *toCharset, const char *inputBuffer, std::size_t inputBufferSize, float outputBufferSizeFactor = 1.0f);
 #endif
 
 #ifdef PLATFORM_WINDOWS
@@ -94,28 +338,28 @@ template <class Container> using StringParamForContainer = std::basic_string_vie
 /// \endcond
 
 /*!
- * \brief Joins the given \a strings using the specified \a delimiter.
+ * \brief Joins the given \a strings using the specified \a delimiter appending the result to \a output.
  *
  * The strings will be enclosed using the provided closures \a leftClosure and \a rightClosure.
  *
+ * \param output The string to append the result to. Its capacity is reused so clearing and passing the same
+ *        string repeatedly avoids allocations.
  * \param strings The string parts to be joined.
  * \param delimiter Specifies a delimiter to be used (empty string by default).
  * \param omitEmpty Indicates whether empty part should be omitted.
  * \param leftClosure Specifies a string to be inserted before each string (empty string by default).
  * \param rightClosure Specifies a string to be appended after each string (empty string by default).
  * \tparam Container Container The STL-container used to provide the \a strings.
- * \tparam ReturnType Type to store the result; defaults to the container's element type.
- * \returns Returns the joined string.
+ * \tparam ReturnType Type of \a output.
+ * \remarks The exact size of the result is computed first so \a output is grown only once. Then the parts are
+ *          copied into place via std::char_traits::copy() (which is memcpy() for char).
  */
 template <class Container = std::initializer_list<std::string>, class ReturnType = Detail::DefaultReturnTypeForContainer<Container>>
-ReturnType joinStrings(const Container &strings, Detail::StringParamForContainer<Container> delimiter = Detail::StringParamForContainer<Container>(),
-    bool omitEmpty = false, Detail::StringParamForContainer<Container> leftClosure = Detail::StringParamForContainer<Container>(),
+void joinStrings(ReturnType &output, const Container &strings,
+    Detail::StringParamForContainer<Container> delimiter = Detail::StringParamForContainer<Container>(), bool omitEmpty = false,
+    Detail::StringParamForContainer<Container> leftClosure = Detail::StringParamForContainer<Container>(),
     Detail::StringParamForContainer<Container> rightClosure = Detail::StringParamForContainer<Container>())
 {
-    ReturnType res;
-    if (!strings.size()) {
-        return res;
-    }
     std::size_t entries = 0, size = 0;
     for (const auto &str : strings) {
         if (omitEmpty && str.empty()) {
@@ -125,21 +369,53 @@ ReturnType joinStrings(const Container &strings, Detail::StringParamForContainer
         ++entries;
     }
     if (!entries) {
-        return res;
+        return;
     }
     size += (entries * leftClosure.size()) + (entries * rightClosure.size()) + ((entries - 1) * delimiter.size());
-    res.reserve(size);
+
+    const auto offset = output.size();
+    output.resize(offset + size);
+    auto *out = output.data() + offset;
+    const auto copy = [&out](const auto *data, std::size_t dataSize) {
+        ReturnType::traits_type::copy(out, data, dataSize);
+        out += dataSize;
+    };
+    auto first = true;
     for (const auto &str : strings) {
         if (omitEmpty && str.empty()) {
             continue;
         }
-        if (!res.empty()) {
-            res.append(delimiter);
+        if (!first) {
+            copy(delimiter.data(), delimiter.size());
         }
-        res.append(leftClosure);
-        res.append(str);
-        res.append(rightClosure);
+        first = false;
+        copy(leftClosure.data(), leftClosure.size());
+        copy(str.data(), str.size());
+        copy(rightClosure.data(), rightClosure.size());
     }
+}
+
+/*!
+ * \brief Joins the given \a strings using the specified \a delimiter.
+ *
+ * The strings will be enclosed using the provided closures \a leftClosure and \a rightClosure.
+ *
+ * \param strings The string parts to be joined.
+ * \param delimiter Specifies a delimiter to be used (empty string by default).
+ * \param omitEmpty Indicates whether empty part should be omitted.
+ * \param leftClosure Specifies a string to be inserted before each string (empty string by default).
+ * \param rightClosure Specifies a string to be appended after each string (empty string by default).
+ * \tparam Container Container The STL-container used to provide the \a strings.
+ * \tparam ReturnType Type to store the result; defaults to the container's element type.
+ * \returns Returns the joined string.
+ */
+template <class Container = std::initializer_list<std::string>, class ReturnType = Detail::DefaultReturnTypeForContainer<Container>>
+ReturnType joinStrings(const Container &strings, Detail::StringParamForContainer<Container> delimiter = Detail::StringParamForContainer<Container>(),
+    bool omitEmpty = false, Detail::StringParamForContainer<Container> leftClosure = Detail::StringParamForContainer<Container>(),
+    Detail::StringParamForContainer<Container> rightClosure = Detail::StringParamForContainer<Container>())
+{
+    ReturnType res;
+    joinStrings<Container, ReturnType>(res, strings, delimiter, omitEmpty, leftClosure, rightClosure);
     return res;
 }
 
@@ -260,6 +536,264 @@ Container splitStringSimple(
     return res;
 }
 
+/*!
+ * \brief The SplitStringIterator class iterates lazily over the parts of a string split at a delimiter.
+ * \remarks
+ * - The parts are determined on the fly and returned as views into the original string. So the string
+ *   must outlive the iteration but no container and no copies of the parts are created.
+ * - The semantics of the EmptyPartsTreat and maxParts parameters are the same as for splitString(). Only parts
+ *   merged via EmptyPartsTreat::Merge need to be copied into a buffer held by the iterator (as they consist of
+ *   non-contiguous segments); the returned view is invalidated when the iterator is advanced in this case.
+ * - Single-char delimiters are searched via std::char_traits::find() which boils down to memchr() for char.
+ * - This is only an input iterator as dereferencing returns the part by value (and not a reference into a sequence
+ *   which stays valid while other iterators are advanced). The range can still be iterated multiple times by
+ *   calling begin() again.
+ * \sa SplitStringRange and splitStringLazily()
+ */
+template <class CharType = char> class SplitStringIterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::basic_string_view<CharType>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = value_type;
+
+    SplitStringIterator();
+    explicit SplitStringIterator(std::basic_string_view<CharType> string, std::basic_string_view<CharType> delimiter,
+        EmptyPartsTreat emptyPartsRole = EmptyPartsTreat::Keep, int maxParts = -1);
+
+    reference operator*() const;
+    SplitStringIterator &operator++();
+    SplitStringIterator operator++(int);
+    bool operator==(const SplitStringIterator &other) const;
+    bool operator!=(const SplitStringIterator &other) const;
+
+private:
+    using SizeType = typename std::basic_string_view<CharType>::size_type;
+    SizeType findDelimiter(SizeType pos) const;
+    void findPart();
+    void mergeParts();
+
+    std::basic_string_view<CharType> m_string;
+    std::basic_string_view<CharType> m_delimiter;
+    std::basic_string_view<CharType> m_part;
+    std::basic_string<CharType> m_mergedPart;
+    SizeType m_pos;
+    SizeType m_partCount;
+    SizeType m_maxParts;
+    EmptyPartsTreat m_emptyPartsRole;
+};
+
+/*!
+ * \brief Constructs the end-iterator.
+ */
+template <class CharType>
+inline SplitStringIterator<CharType>::SplitStringIterator()
+    : m_pos(std::basic_string_view<CharType>::npos)
+    , m_partCount(0)
+    , m_maxParts(std::basic_string_view<CharType>::npos)
+    , m_emptyPartsRole(EmptyPartsTreat::Keep)
+{
+}
+
+/*!
+ * \brief Constructs an iterator pointing to the first part of \a string.
+ * \remarks See splitString() for the meaning of the parameters.
+ */
+template <class CharType>
+inline SplitStringIterator<CharType>::SplitStringIterator(std::basic_string_view<CharType> string, std::basic_string_view<CharType> delimiter,
+    EmptyPartsTreat emptyPartsRole, int maxParts)
+    : m_string(string)
+    , m_delimiter(delimiter)
+    , m_pos(0)
+    , m_partCount(0)
+    , m_maxParts(maxParts > 0 ? static_cast<SizeType>(maxParts - 1) : std::basic_string_view<CharType>::npos)
+    , m_emptyPartsRole(emptyPartsRole)
+{
+    findPart();
+}
+
+/*!
+ * \brief Returns the current part.
+ */
+template <class CharType> inline typename SplitStringIterator<CharType>::reference SplitStringIterator<CharType>::operator*() const
+{
+    return m_mergedPart.empty() ? m_part : std::basic_string_view<CharType>(m_mergedPart);
+}
+
+/*!
+ * \brief Advances to the next part.
+ */
+template <class CharType> inline SplitStringIterator<CharType> &SplitStringIterator<CharType>::operator++()
+{
+    findPart();
+    return *this;
+}
+
+/*!
+ * \brief Advances to the next part returning the previous state.
+ */
+template <class CharType> inline SplitStringIterator<CharType> SplitStringIterator<CharType>::operator++(int)
+{
+    auto previous = *this;
+    ++*this;
+    return previous;
+}
+
+/*!
+ * \brief Returns whether the iterator points to the same part as \a other.
+ * \remarks Only meaningful for iterators over the same string (or the end-iterator).
+ */
+template <class CharType> inline bool SplitStringIterator<CharType>::operator==(const SplitStringIterator &other) const
+{
+    return m_pos == other.m_pos;
+}
+
+/*!
+ * \brief Returns whether the iterator points to a different part than \a other.
+ */
+template <class CharType> inline bool SplitStringIterator<CharType>::operator!=(const SplitStringIterator &other) const
+{
+    return m_pos != other.m_pos;
+}
+
+/// \cond
+template <class CharType>
+inline typename SplitStringIterator<CharType>::SizeType SplitStringIterator<CharType>::findDelimiter(SizeType pos) const
+{
+    return m_delimiter.size() == 1 ? m_string.find(m_delimiter.front(), pos) : m_string.find(m_delimiter, pos);
+}
+
+template <class CharType> void SplitStringIterator<CharType>::findPart()
+{
+    constexpr auto npos = std::basic_string_view<CharType>::npos;
+    const auto end = m_string.size();
+    m_mergedPart.clear();
+    for (; m_pos < end;) {
+        auto delimPos = m_partCount == m_maxParts ? npos : findDelimiter(m_pos);
+        if (delimPos == npos) {
+            delimPos = end;
+        }
+        if (m_emptyPartsRole == EmptyPartsTreat::Keep || m_pos != delimPos) {
+            m_part = m_string.substr(m_pos, delimPos - m_pos);
+            m_pos = delimPos + m_delimiter.size();
+            ++m_partCount;
+            if (m_emptyPartsRole == EmptyPartsTreat::Merge) {
+                mergeParts();
+            }
+            return;
+        }
+        m_pos = delimPos + m_delimiter.size();
+    }
+    if (m_pos == end && m_emptyPartsRole == EmptyPartsTreat::Keep) {
+        // the string is empty or ends with the delimiter: yield a final empty part
+        m_part = m_string.substr(end);
+        ++m_pos;
+        return;
+    }
+    m_pos = npos;
+}
+
+template <class CharType> void SplitStringIterator<CharType>::mergeParts()
+{
+    // append subsequent parts which are separated from the current part only by empty parts (like splitString() does)
+    constexpr auto npos = std::basic_string_view<CharType>::npos;
+    const auto end = m_string.size();
+    for (auto merge = false; m_pos < end;) {
+        auto delimPos = findDelimiter(m_pos);
+        if (!merge && m_partCount == m_maxParts && delimPos != m_pos) {
+            return;
+        }
+        if (delimPos == npos) {
+            delimPos = end;
+        }
+        if (m_pos == delimPos) {
+            merge = true;
+        } else if (!merge) {
+            return;
+        } else {
+            if (m_mergedPart.empty()) {
+                m_mergedPart.append(m_part);
+            }
+            m_mergedPart.append(m_delimiter);
+            m_mergedPart.append(m_string.substr(m_pos, delimPos - m_pos));
+            merge = false;
+        }
+        m_pos = delimPos + m_delimiter.size();
+    }
+}
+/// \endcond
+
+/*!
+ * \brief The SplitStringRange class allows iterating lazily over the parts of a string using a range-based for loop.
+ * \sa splitStringLazily() for an example
+ */
+template <class CharType = char> class SplitStringRange {
+public:
+    explicit SplitStringRange(std::basic_string_view<CharType> string, std::basic_string_view<CharType> delimiter,
+        EmptyPartsTreat emptyPartsRole = EmptyPartsTreat::Keep, int maxParts = -1);
+
+    SplitStringIterator<CharType> begin() const;
+    SplitStringIterator<CharType> end() const;
+
+private:
+    std::basic_string_view<CharType> m_string;
+    std::basic_string_view<CharType> m_delimiter;
+    EmptyPartsTreat m_emptyPartsRole;
+    int m_maxParts;
+};
+
+/*!
+ * \brief Constructs a new range for the parts of \a string.
+ * \remarks See splitString() for the meaning of the parameters.
+ */
+template <class CharType>
+inline SplitStringRange<CharType>::SplitStringRange(
+    std::basic_string_view<CharType> string, std::basic_string_view<CharType> delimiter, EmptyPartsTreat emptyPartsRole, int maxParts)
+    : m_string(string)
+    , m_delimiter(delimiter)
+    , m_emptyPartsRole(emptyPartsRole)
+    , m_maxParts(maxParts)
+{
+}
+
+/*!
+ * \brief Returns an iterator pointing to the first part.
+ */
+template <class CharType> inline SplitStringIterator<CharType> SplitStringRange<CharType>::begin() const
+{
+    return SplitStringIterator<CharType>(m_string, m_delimiter, m_emptyPartsRole, m_maxParts);
+}
+
+/*!
+ * \brief Returns an iterator pointing past the last part.
+ */
+template <class CharType> inline SplitStringIterator<CharType> SplitStringRange<CharType>::end() const
+{
+    return SplitStringIterator<CharType>();
+}
+
+/*!
+ * \brief Splits the given \a string at the specified \a delimiter lazily.
+ * \param string The string to be split; it must outlive the returned range.
+ * \param delimiter Specifies the delimiter which must not be empty.
+ * \param emptyPartsRole Specifies the treatment of empty parts.
+ * \param maxParts Specifies the maximal number of parts. Values less or equal zero indicate an unlimited number of parts.
+ * \returns Returns a range over the parts which yields the same parts as splitString() without allocating a container.
+ *
+ * Example:
+ * ```
+ * for (const auto line : splitStringLazily(output, "\n", EmptyPartsTreat::Omit)) {
+ *     // line is a std::string_view
+ * }
+ * ```
+ */
+inline SplitStringRange<char> splitStringLazily(
+    std::string_view string, std::string_view delimiter, EmptyPartsTreat emptyPartsRole = EmptyPartsTreat::Keep, int maxParts = -1)
+{
+    return SplitStringRange<char>(string, delimiter, emptyPartsRole, maxParts);
+}
+
 /*!
  * \brief Converts the specified \a multilineString to an array of lines.
  */
@@ -423,77 +957,176 @@ template <typename CharType> constexpr CharType digitToChar(CharType digit)
     return digit <= 9 ? (digit + '0') : (digit + 'A' - 10);
 }
 
+/// \cond
+namespace Detail {
+/// \brief Holds the decimal representations of 0 to 99 so integers can be formatted two digits at a time.
+inline constexpr char decimalDigitPairs[] = "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+                                             "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+/// \brief Formats \a number using \a base writing the digits backwards ending at \a end.
+/// \returns Returns a pointer to the first digit.
+template <typename UnsignedType> char *formatUnsignedInteger(UnsignedType number, UnsignedType base, char *end)
+{
+    auto *begin = end;
+    if (base == 10) {
+        for (; number >= 100; number /= 100) {
+            std::memcpy(begin -= 2, decimalDigitPairs + (number % 100) * 2, 2);
+        }
+        if (number >= 10) {
+            std::memcpy(begin -= 2, decimalDigitPairs + number * 2, 2);
+        } else {
+            *--begin = static_cast<char>('0' + number);
+        }
+        return begin;
+    }
+    do {
+        *--begin = digitToChar<char>(static_cast<char>(number % base));
+        number /= base;
+    } while (number);
+    return begin;
+}
+
+/// \brief Formats \a number writing the digits backwards ending at \a end (prepending '-' if \a number is negative).
+/// \returns Returns a pointer to the first character.
+template <typename IntegralType, typename BaseType> char *formatInteger(IntegralType number, BaseType base, char *end)
+{
+    if constexpr (std::is_unsigned_v<IntegralType>) {
+        return formatUnsignedInteger<IntegralType>(number, static_cast<IntegralType>(base), end);
+    } else {
+        using UnsignedType = std::make_unsigned_t<IntegralType>;
+        const auto negative = number < 0;
+        // negate the unsigned value so the minimum is formatted correctly as well
+        const auto magnitude
+            = negative ? static_cast<UnsignedType>(UnsignedType() - static_cast<UnsignedType>(number)) : static_cast<UnsignedType>(number);
+        auto *const begin = formatUnsignedInteger<UnsignedType>(magnitude, static_cast<UnsignedType>(base), end);
+        if (negative) {
+            *(begin - 1) = '-';
+            return begin - 1;
+        }
+        return begin;
+    }
+}
+
+/// \brief Appends the characters from \a begin to \a end to \a output (widening them if \a output is no narrow string).
+template <class StringType> inline void appendFormattedNumber(StringType &output, const char *begin, const char *end)
+{
+    if constexpr (std::is_same_v<typename StringType::value_type, char>) {
+        output.append(begin, static_cast<std::size_t>(end - begin));
+    } else {
+        output.append(begin, end);
+    }
+}
+
+/// \brief Returns the buffer size required by formatInteger() for \a IntegralType (base 2 and sign).
+template <typename IntegralType> constexpr std::size_t formattedIntegerBufferSize()
+{
+    return static_cast<std::size_t>(std::numeric_limits<IntegralType>::digits) + 2;
+}
+} // namespace Detail
+/// \endcond
+
 /*!
  * \brief Converts the given \a number to its equivalent string representation using the specified \a base.
  * \tparam IntegralType The data type of the given number.
  * \tparam StringType The string type (should be an instantiation of the basic_string class template).
+ * \remarks Decimal numbers are formatted two digits at a time using a lookup table.
  * \sa stringToNumber()
  */
 template <typename IntegralType, class StringType = std::string, typename BaseType = IntegralType,
     CppUtilities::Traits::EnableIf<std::is_integral<IntegralType>, std::is_unsigned<IntegralType>> * = nullptr>
 StringType numberToString(IntegralType number, BaseType base = 10)
 {
-    auto resSize = std::size_t();
-    auto n = number;
-    do {
-        n /= static_cast<IntegralType>(base), ++resSize;
-    } while (n);
-    auto res = StringType(resSize, typename StringType::value_type());
-    auto resIter = res.end();
-    do {
-        *(--resIter)
-            = digitToChar<typename StringType::value_type>(static_cast<typename StringType::value_type>(number % static_cast<IntegralType>(base)));
-        number /= static_cast<IntegralType>(base);
-    } while (number);
-    return res;
+    char buffer[Detail::formattedIntegerBufferSize<IntegralType>()];
+    auto *const end = buffer + sizeof(buffer);
+    return StringType(Detail::formatInteger(number, base, end), end);
 }
 
 /*!
  * \brief Converts the given \a number to its equivalent string representation using the specified \a base.
  * \tparam IntegralType The data type of the given number.
  * \tparam StringType The string type (should be an instantiation of the basic_string class template).
+ * \remarks Decimal numbers are formatted two digits at a time using a lookup table.
  * \sa stringToNumber()
  */
 template <typename IntegralType, class StringType = std::string, typename BaseType = IntegralType,
     Traits::EnableIf<std::is_integral<IntegralType>, std::is_signed<IntegralType>> * = nullptr>
 StringType numberToString(IntegralType number, BaseType base = 10)
 {
-    const auto negative = number < 0;
-    auto resSize = std::size_t();
-    if (negative) {
-        number = -number, resSize = 1;
-    }
-    auto n = number;
-    do {
-        n /= static_cast<IntegralType>(base), ++resSize;
-    } while (n);
-    auto res = StringType(resSize, typename StringType::value_type());
-    auto resIter = res.end();
-    do {
-        *(--resIter)
-            = digitToChar<typename StringType::value_type>(static_cast<typename StringType::value_type>(number % static_cast<IntegralType>(base)));
-        number /= static_cast<IntegralType>(base);
-    } while (number);
-    if (negative) {
-        *(--resIter) = '-';
+    char buffer[Detail::formattedIntegerBufferSize<IntegralType>()];
+    auto *const end = buffer + sizeof(buffer);
+    return StringType(Detail::formatInteger(number, base, end), end);
+}
+
+/*!
+ * \brief Appends the string representation of the given \a number using the specified \a base to \a output.
+ * \tparam IntegralType The data type of the given number.
+ * \tparam StringType The string type (must be an instantiation of the basic_string class template).
+ * \remarks This allows formatting many numbers into the same buffer without allocating a string for each number.
+ * \sa stringToNumber()
+ */
+template <typename IntegralType, class StringType = std::string, typename BaseType = IntegralType,
+    Traits::EnableIf<std::is_integral<IntegralType>, Traits::IsSpecializationOf<StringType, std::basic_string>> * = nullptr>
+void numberToString(StringType &output, IntegralType number, BaseType base = 10)
+{
+    char buffer[Detail::formattedIntegerBufferSize<IntegralType>()];
+    auto *const end = buffer + sizeof(buffer);
+    Detail::appendFormattedNumber(output, Detail::formatInteger(number, base, end), end);
+}
+
+/// \cond
+namespace Detail {
+/// \brief Formats \a number as shortest representation which round-trips via std::to_chars() (if supported); otherwise formats it
+///        with as many digits as needed to round-trip via std::basic_stringstream.
+template <typename FloatingType, class StringType> void appendFloatingPointNumber(StringType &output, FloatingType number, int base)
+{
+#ifdef __cpp_lib_to_chars
+    char buffer[128];
+    if (const auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), number); ec == std::errc()) {
+        appendFormattedNumber(output, buffer, end);
+        return;
     }
-    return res;
+#endif
+    std::basic_stringstream<typename StringType::value_type> ss;
+    ss << std::setbase(base) << std::setprecision(std::numeric_limits<FloatingType>::max_digits10) << number;
+    output.append(ss.str());
 }
+} // namespace Detail
+/// \endcond
 
 /*!
  * \brief Converts the given \a number to its equivalent string representation using the specified \a base.
  * \tparam FloatingType The data type of the given number.
  * \tparam StringType The string type (should be an instantiation of the basic_string class template).
- * \remarks This function is using std::basic_stringstream internally and hence also has its limitations (eg. regarding
- *          \a base and types).
+ * \remarks
+ * - The resulting string can always be converted back to the exact same value. If the standard library supports
+ *   std::to_chars() for floating point numbers the shortest such representation is used. Otherwise std::basic_stringstream
+ *   is used with std::numeric_limits<FloatingType>::max_digits10 significant digits (so e.g. 0.1 is formatted as
+ *   "0.10000000000000001").
+ * - Previously std::basic_stringstream was always used with its default precision of 6 significant digits. So the output
+ *   differs for numbers which need more digits, e.g. 123456789.0 was formatted as "1.23457e+08" and is now formatted
+ *   as "123456789".
+ * - The \a base is only taken into account for std::basic_stringstream (and even then has no effect).
  * \sa stringToNumber(), bufferToNumber()
  */
 template <typename FloatingType, class StringType = std::string, Traits::EnableIf<std::is_floating_point<FloatingType>> * = nullptr>
 StringType numberToString(FloatingType number, int base = 10)
 {
-    std::basic_stringstream<typename StringType::value_type> ss;
-    ss << std::setbase(base) << number;
-    return ss.str();
+    auto res = StringType();
+    Detail::appendFloatingPointNumber(res, number, base);
+    return res;
+}
+
+/*!
+ * \brief Appends the string representation of the given \a number to \a output.
+ * \tparam FloatingType The data type of the given number.
+ * \tparam StringType The string type (must be an instantiation of the basic_string class template).
+ * \remarks See numberToString(FloatingType, int) for details.
+ */
+template <typename FloatingType, class StringType = std::string,
+    Traits::EnableIf<std::is_floating_point<FloatingType>, Traits::IsSpecializationOf<StringType, std::basic_string>> * = nullptr>
+void numberToString(StringType &output, FloatingType number, int base = 10)
+{
+    Detail::appendFloatingPointNumber(output, number, base);
 }
 
 /*!
@@ -541,6 +1174,104 @@ void raiseAndAdd(IntegralType &result, BaseType base, CharType character)
     result += static_cast<IntegralType>(charToDigit<CharType>(character, static_cast<CharType>(base)));
 #endif
 }
+
+/// \brief Returns whether all 8 characters loaded into \a chunk are decimal digits.
+constexpr bool isEightDecimalDigits(std::uint64_t chunk)
+{
+    return ((chunk & 0xF0F0F0F0F0F0F0F0u) | (((chunk + 0x0606060606060606u) & 0xF0F0F0F0F0F0F0F0u) >> 4)) == 0x3333333333333333u;
+}
+
+/// \brief Returns the value of the 8 decimal digits loaded (in little-endian byte order) into \a chunk.
+/// \remarks Combines adjacent digits, then adjacent pairs and then adjacent quadruples using 3 multiplications.
+constexpr std::uint64_t parseEightDecimalDigits(std::uint64_t chunk)
+{
+    chunk = ((chunk & 0x0F0F0F0F0F0F0F0Fu) * 2561u) >> 8;
+    chunk = ((chunk & 0x00FF00FF00FF00FFu) * 6553601u) >> 16;
+    return ((chunk & 0x0000FFFF0000FFFFu) * 42949672960001u) >> 32;
+}
+
+/// \brief Assigns \a value (negated if \a negative is set) to \a result if it is within the limits of \a IntegralType.
+/// \returns Returns whether \a value is within the limits.
+template <typename IntegralType> inline bool applySign(std::uint64_t value, bool negative, IntegralType &result)
+{
+    using UnsignedType = std::make_unsigned_t<IntegralType>;
+    const auto limit = static_cast<std::uint64_t>(std::numeric_limits<IntegralType>::max()) + (negative ? 1u : 0u);
+    if (value > limit) {
+        return false;
+    }
+    result = static_cast<IntegralType>(negative ? static_cast<UnsignedType>(UnsignedType() - static_cast<UnsignedType>(value))
+                                                : static_cast<UnsignedType>(value));
+    return true;
+}
+
+/// \brief Parses \a begin to \a end as decimal number (optionally prefixed by '-' if \a IntegralType is signed).
+/// \returns Returns whether the string has been parsed successfully. Returns false if the string contains any other
+///          characters, is empty, has more than 19 digits or is out of range for \a IntegralType.
+template <typename IntegralType> bool parseDecimalNumber(const char *begin, const char *end, IntegralType &result)
+{
+    auto negative = false;
+    if constexpr (std::is_signed_v<IntegralType>) {
+        if (begin != end && *begin == '-') {
+            negative = true;
+            ++begin;
+        }
+    }
+    if (begin == end || end - begin > std::numeric_limits<std::uint64_t>::digits10) {
+        return false;
+    }
+    auto value = std::uint64_t();
+    for (; end - begin >= 8; begin += 8) {
+        const auto chunk = LE::toUInt64(begin);
+        if (!isEightDecimalDigits(chunk)) {
+            return false;
+        }
+        value = value * 100000000u + parseEightDecimalDigits(chunk);
+    }
+    for (; begin != end; ++begin) {
+        const auto digit = static_cast<unsigned char>(*begin - '0');
+        if (digit > 9) {
+            return false;
+        }
+        value = value * 10u + digit;
+    }
+    return applySign(value, negative, result);
+}
+
+/// \brief Returns \a magnitude (negated if \a negative is set) as \a IntegralType.
+/// \throws Throws a ConversionException if the result exceeds the limits of \a IntegralType.
+template <typename IntegralType> IntegralType applySign(std::make_unsigned_t<IntegralType> magnitude, bool negative)
+{
+    auto result = IntegralType();
+    if (!applySign(magnitude, negative, result)) {
+        throw ConversionException("Number exceeds limit.");
+    }
+    return result;
+}
+
+/// \brief Parses the specified \a string of \a size characters using \a base without considering spaces.
+/// \returns Returns whether the string has been parsed successfully. If not, the caller needs to fall back to
+///          parsing the string character by character (to skip spaces and to report invalid characters).
+/// \throws Throws a ConversionException if the number exceeds the limits of \a IntegralType.
+template <typename IntegralType, typename CharType, typename BaseType>
+bool parseNumber(const CharType *string, std::size_t size, BaseType base, IntegralType &result)
+{
+    if constexpr (!std::is_same_v<CharType, char> || std::is_same_v<IntegralType, bool>) {
+        return false;
+    } else {
+        const auto *const end = string + size;
+        if (base == 10 && parseDecimalNumber(string, end, result)) {
+            return true;
+        }
+        if (base < 2 || base > 36) {
+            return false;
+        }
+        const auto [ptr, ec] = std::from_chars(string, end, result, static_cast<int>(base));
+        if (ec == std::errc::result_out_of_range) {
+            throw ConversionException("Number exceeds limit.");
+        }
+        return ec == std::errc() && ptr == end;
+    }
+}
 } // namespace Detail
 /// \endcond
 
@@ -549,6 +1280,8 @@ void raiseAndAdd(IntegralType &result, BaseType base, CharType character)
  * \tparam IntegralType The data type used to store the converted value.
  * \tparam CharType The character type.
  * \throws A ConversionException will be thrown if the provided \a string is not a valid number.
+ * \remarks Strings of type char without spaces are parsed via std::from_chars() (decimal numbers 8 digits at a time
+ *          via SWAR); only other strings are parsed character by character.
  * \sa numberToString(), stringToNumber()
  */
 template <typename IntegralType, class CharType, typename BaseType = IntegralType,
@@ -556,6 +1289,10 @@ template <typename IntegralType, class CharType, typename BaseType = IntegralTyp
 IntegralType bufferToNumber(const CharType *string, std::size_t size, BaseType base = 10)
 {
     IntegralType result = 0;
+    if (Detail::parseNumber(string, size, base, result)) {
+        return result;
+    }
+    result = 0;
     for (const CharType *end = string + size; string != end; ++string) {
         Detail::raiseAndAdd(result, base, *string);
     }
@@ -567,6 +1304,8 @@ IntegralType bufferToNumber(const CharType *string, std::size_t size, BaseType b
  * \tparam IntegralType The data type used to store the converted value.
  * \tparam CharType The character type.
  * \throws A ConversionException will be thrown if the provided \a string is not a valid number.
+ * \remarks Strings of type char without spaces are parsed via std::from_chars() (decimal numbers 8 digits at a time
+ *          via SWAR); only other strings are parsed character by character.
  * \sa numberToString(), stringToNumber()
  */
 template <typename IntegralType, typename CharType, typename BaseType = IntegralType,
@@ -576,6 +1315,9 @@ IntegralType bufferToNumber(const CharType *string, std::size_t size, BaseType b
     if (!size) {
         return 0;
     }
+    if (auto result = IntegralType(); Detail::parseNumber(string, size, base, result)) {
+        return result;
+    }
     const CharType *end = string + size;
     for (; string != end && *string == ' '; ++string)
         ;
@@ -586,11 +1328,12 @@ IntegralType bufferToNumber(const CharType *string, std::size_t size, BaseType b
     if (negative) {
         ++string;
     }
-    IntegralType result = 0;
+    // accumulate the magnitude unsigned so the minimum of IntegralType (which has no positive counterpart) can be parsed
+    auto magnitude = std::make_unsigned_t<IntegralType>();
     for (; string != end; ++string) {
-        Detail::raiseAndAdd(result, base, *string);
+        Detail::raiseAndAdd(magnitude, base, *string);
     }
-    return negative ? -result : result;
+    return Detail::applySign<IntegralType>(magnitude, negative);
 }
 
 /*!
@@ -664,6 +1407,10 @@ template <typename IntegralType, typename CharType, typename BaseType = Integral
 IntegralType stringToNumber(const CharType *string, BaseType base = 10)
 {
     IntegralType result = 0;
+    if (Detail::parseNumber(string, std::char_traits<CharType>::length(string), base, result)) {
+        return result;
+    }
+    result = 0;
     for (; *string; ++string) {
         Detail::raiseAndAdd(result, base, *string);
     }
@@ -699,6 +1446,9 @@ IntegralType stringToNumber(const CharType *string, IntegralType base = 10)
     if (!*string) {
         return 0;
     }
+    if (auto result = IntegralType(); Detail::parseNumber(string, std::char_traits<CharType>::length(string), base, result)) {
+        return result;
+    }
     for (; *string && *string == ' '; ++string)
         ;
     if (!*string) {
@@ -708,11 +1458,92 @@ IntegralType stringToNumber(const CharType *string, IntegralType base = 10)
     if (negative) {
         ++string;
     }
-    IntegralType result = 0;
+    // accumulate the magnitude unsigned so the minimum of IntegralType (which has no positive counterpart) can be parsed
+    auto magnitude = std::make_unsigned_t<IntegralType>();
     for (; *string; ++string) {
-        Detail::raiseAndAdd(result, base, *string);
+        Detail::raiseAndAdd(magnitude, base, *string);
+    }
+    return Detail::applySign<IntegralType>(magnitude, negative);
+}
+
+/*!
+ * \brief Parses the integers within \a string separated by any of the specified \a delimiters appending them to \a output.
+ * \tparam Container The STL-container used to store the converted values.
+ * \tparam IntegralType The data type used to store the converted values; defaults to the container's element type.
+ * \throws A ConversionException will be thrown if a part is not a valid number. Values parsed so far remain in \a output.
+ * \remarks
+ * - Empty parts (e.g. caused by consecutive delimiters or a trailing line break) are skipped.
+ * - The parts are parsed in place via bufferToNumber() so no intermediate strings are created.
+ * \sa stringToNumber(), bufferToNumber()
+ */
+template <class Container, typename IntegralType = typename Container::value_type, typename BaseType = IntegralType,
+    Traits::EnableIf<std::is_integral<IntegralType>> * = nullptr>
+void stringToNumbers(Container &output, std::string_view string, std::string_view delimiters = ",", BaseType base = 10)
+{
+    // use a lookup table for checking for delimiters as std::string_view::find_first_of() checks each delimiter individually
+    bool isDelimiter[256] = {};
+    for (const auto delimiter : delimiters) {
+        isDelimiter[static_cast<unsigned char>(delimiter)] = true;
+    }
+    for (const char *begin = string.data(), *const end = begin + string.size(); begin != end;) {
+        // parse decimal numbers while searching for the end of the part (so the part is only read once); fall back to
+        // bufferToNumber() if the part contains any other characters or is out of range
+        if (base == 10) {
+            auto *digit = begin;
+            const auto negative = std::is_signed_v<IntegralType> && *digit == '-';
+            digit += negative;
+            auto *const digitsBegin = digit;
+            auto value = std::uint64_t();
+            for (unsigned char digitValue; digit != end && (digitValue = static_cast<unsigned char>(*digit - '0')) <= 9; ++digit) {
+                value = value * 10u + digitValue;
+            }
+            if (auto number = IntegralType(); (digit == end || isDelimiter[static_cast<unsigned char>(*digit)]) && digit != digitsBegin
+                && digit - digitsBegin <= std::numeric_limits<std::uint64_t>::digits10 && Detail::applySign(value, negative, number)) {
+                output.emplace_back(number);
+                if (digit == end) {
+                    break;
+                }
+                begin = digit + 1;
+                continue;
+            }
+        }
+        auto *partEnd = begin;
+        if (delimiters.size() == 1) {
+            partEnd = static_cast<const char *>(std::memchr(begin, delimiters.front(), static_cast<std::size_t>(end - begin)));
+            partEnd = partEnd ? partEnd : end;
+        } else {
+            for (; partEnd != end && !isDelimiter[static_cast<unsigned char>(*partEnd)]; ++partEnd)
+                ;
+        }
+        if (partEnd != begin) {
+            output.emplace_back(bufferToNumber<IntegralType>(begin, static_cast<std::size_t>(partEnd - begin), base));
+        }
+        if (partEnd == end) {
+            break;
+        }
+        begin = partEnd + 1;
     }
-    return negative ? -result : result;
+}
+
+/*!
+ * \brief Parses the integers within \a string separated by any of the specified \a delimiters.
+ * \tparam IntegralType The data type used to store the converted values.
+ * \tparam Container The STL-container used to return the converted values.
+ * \throws A ConversionException will be thrown if a part is not a valid number.
+ * \remarks See the overload taking an output container for details.
+ *
+ * Example:
+ * ```
+ * const auto samples = stringToNumbers<std::int32_t>("1,-2\n3,4\n", ",\n"); // { 1, -2, 3, 4 }
+ * ```
+ */
+template <typename IntegralType, class Container = std::vector<IntegralType>, typename BaseType = IntegralType,
+    Traits::EnableIf<std::is_integral<IntegralType>> * = nullptr>
+Container stringToNumbers(std::string_view string, std::string_view delimiters = ",", BaseType base = 10)
+{
+    auto res = Container();
+    stringToNumbers<Container, IntegralType, BaseType>(res, string, delimiters, base);
+    return res;
 }
 
 /*!
@@ -735,6 +1566,94 @@ CPP_UTILITIES_EXPORT std::string dataSizeToString(std::uint64_t sizeInByte, bool
 CPP_UTILITIES_EXPORT std::string bitrateToString(double speedInKbitsPerSecond, bool useByteInsteadOfBits = false);
 CPP_UTILITIES_EXPORT std::string encodeBase64(const std::uint8_t *data, std::uint32_t dataSize);
 CPP_UTILITIES_EXPORT std::pair<std::unique_ptr<std::uint8_t[]>, std::uint32_t> decodeBase64(const char *encodedStr, const std::uint32_t strSize);
+
+/*!
+ * \brief The Base64DecodeOptions enum specifies options for decoding Base64.
+ */
+enum class Base64DecodeOptions {
+    None = 0, /**< only characters of the Base64 alphabet and padding are accepted */
+    SkipWhitespace = (1 << 0), /**< whitespace (e.g. line breaks within a PEM body) is ignored */
+};
+
+class CPP_UTILITIES_EXPORT Base64Encoder {
+public:
+    Base64Encoder();
+
+    std::size_t encode(const std::uint8_t *data, std::size_t dataSize, char *output);
+    std::size_t finish(char *output);
+    static constexpr std::size_t maxOutputSize(std::size_t dataSize);
+
+private:
+    std::uint8_t m_pendingData[2];
+    std::uint8_t m_pendingDataSize;
+};
+
+/*!
+ * \brief Constructs a new encoder.
+ */
+inline Base64Encoder::Base64Encoder()
+    : m_pendingData{}
+    , m_pendingDataSize(0)
+{
+}
+
+/*!
+ * \brief Returns the output buffer size which is always sufficient for encode() and finish() to encode \a dataSize bytes.
+ * \remarks This is also the exact size of the Base64 representation of \a dataSize bytes (including padding).
+ */
+constexpr std::size_t Base64Encoder::maxOutputSize(std::size_t dataSize)
+{
+    return (dataSize + 2) / 3 * 4;
+}
+
+class CPP_UTILITIES_EXPORT Base64Decoder {
+public:
+    explicit Base64Decoder(Base64DecodeOptions options = Base64DecodeOptions::None);
+
+    Base64DecodeOptions options() const;
+    std::size_t decode(const char *encodedStr, std::size_t strSize, std::uint8_t *output);
+    void finish();
+    static constexpr std::size_t maxOutputSize(std::size_t strSize);
+
+private:
+    std::uint8_t m_pendingValues[3];
+    std::uint8_t m_pendingValueCount;
+    std::uint8_t m_paddingSize;
+    Base64DecodeOptions m_options;
+};
+
+/*!
+ * \brief Constructs a new decoder with the specified \a options.
+ */
+inline Base64Decoder::Base64Decoder(Base64DecodeOptions options)
+    : m_pendingValues{}
+    , m_pendingValueCount(0)
+    , m_paddingSize(0)
+    , m_options(options)
+{
+}
+
+/*!
+ * \brief Returns the options the decoder has been constructed with.
+ */
+inline Base64DecodeOptions Base64Decoder::options() const
+{
+    return m_options;
+}
+
+/*!
+ * \brief Returns the output buffer size which is always sufficient for decode() to decode \a strSize characters.
+ */
+constexpr std::size_t Base64Decoder::maxOutputSize(std::size_t strSize)
+{
+    return (strSize + 3) / 4 * 3;
+}
+
+CPP_UTILITIES_EXPORT std::size_t encodeBase64(const std::uint8_t *data, std::size_t dataSize, char *output);
+CPP_UTILITIES_EXPORT std::size_t decodeBase64(
+    const char *encodedStr, std::size_t strSize, std::uint8_t *output, Base64DecodeOptions options = Base64DecodeOptions::None);
 } // namespace CppUtilities
 
+CPP_UTILITIES_MARK_FLAG_ENUM_CLASS(CppUtilities, CppUtilities::Base64DecodeOptions);
+
 #endif // CONVERSION_UTILITIES_STRINGCONVERSION_H
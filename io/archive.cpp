@@ -1,11 +1,38 @@
 #include "./archive.h"
 
+#include "../conversion/conversionexception.h"
 #include "../conversion/stringbuilder.h"
+#include "../io/binaryreader.h"
+#include "../io/binarywriter.h"
+#include "../io/nativefilestream.h"
 
 #include <archive.h>
 #include <archive_entry.h>
 
+#if defined(PLATFORM_UNIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#elif defined(PLATFORM_WINDOWS)
+#include "../conversion/stringconversion.h"
+#include <windows.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <filesystem>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
 #include <utility>
 
 using namespace CppUtilities;
@@ -74,8 +101,123 @@ struct ArchiveHandle {
     struct archive *handle;
 };
 
+/// \brief Builds a CompactFileMap in one pass over the archive by appending everything to the buffer of the map.
+struct CompactFileMapBuilder {
+    /// \brief A file or directory; string views are kept as offsets as the buffer might be reallocated while building.
+    struct Record {
+        std::size_t directoryOffset = 0, directorySize = 0;
+        std::size_t nameOffset = 0, nameSize = 0;
+        std::size_t contentOffset = 0, contentSize = 0;
+        DateTime creationTime, modificationTime;
+        ArchiveFileType type = ArchiveFileType::Regular;
+        bool isFile = false;
+    };
+
+    std::string_view view(std::size_t offset, std::size_t size) const;
+    std::size_t append(std::string_view data);
+    void setDirectory(Record &record, std::string_view directoryPath);
+    bool addDirectory(std::string_view directoryPath);
+    bool addFileChunk(std::string_view directoryPath, const ArchiveFile &file, const ArchiveFileChunk &chunk);
+    CompactFileMap finalize();
+
+    CompactFileMap map;
+    std::vector<Record> records;
+    Record currentFile;
+    bool hasCurrentFile = false;
+};
+
+std::string_view CompactFileMapBuilder::view(std::size_t offset, std::size_t size) const
+{
+    return std::string_view(map.m_data.data() + offset, size);
+}
+
+std::size_t CompactFileMapBuilder::append(std::string_view data)
+{
+    const auto offset = map.m_data.size();
+    map.m_data.insert(map.m_data.end(), data.begin(), data.end());
+    return offset;
+}
+
+void CompactFileMapBuilder::setDirectory(Record &record, std::string_view directoryPath)
+{
+    // files of the same directory are usually consecutive so it is sufficient to re-use the path of the previous record
+    if (!records.empty()) {
+        if (const auto &previous = records.back(); view(previous.directoryOffset, previous.directorySize) == directoryPath) {
+            record.directoryOffset = previous.directoryOffset;
+            record.directorySize = previous.directorySize;
+            return;
+        }
+    }
+    record.directoryOffset = append(directoryPath);
+    record.directorySize = directoryPath.size();
+}
+
+bool CompactFileMapBuilder::addDirectory(std::string_view directoryPath)
+{
+    auto record = Record();
+    setDirectory(record, directoryPath);
+    records.emplace_back(record);
+    return false;
+}
+
+bool CompactFileMapBuilder::addFileChunk(std::string_view directoryPath, const ArchiveFile &file, const ArchiveFileChunk &chunk)
+{
+    if (!hasCurrentFile) {
+        hasCurrentFile = true;
+        currentFile = Record();
+        setDirectory(currentFile, directoryPath);
+        currentFile.nameOffset = append(file.name);
+        currentFile.nameSize = file.name.size();
+        currentFile.contentOffset = append(file.content); // the target of symlinks
+        currentFile.creationTime = file.creationTime;
+        currentFile.modificationTime = file.modificationTime;
+        currentFile.type = file.type;
+        currentFile.isFile = true;
+    }
+    if (const auto end = currentFile.contentOffset + chunk.offset; end > map.m_data.size()) {
+        map.m_data.resize(end); // fill holes of sparse files with zeroes
+    }
+    append(chunk.data);
+    if (chunk.isLast) {
+        currentFile.contentSize = map.m_data.size() - currentFile.contentOffset;
+        records.emplace_back(currentFile);
+        hasCurrentFile = false;
+    }
+    return false;
+}
+
+CompactFileMap CompactFileMapBuilder::finalize()
+{
+    // group records by directory (stable to preserve the order of files within the archive)
+    std::stable_sort(records.begin(), records.end(), [this](const Record &lhs, const Record &rhs) {
+        return view(lhs.directoryOffset, lhs.directorySize) < view(rhs.directoryOffset, rhs.directorySize);
+    });
+
+    // create files first so the directories can refer to them as the vector of files is not reallocated anymore
+    map.m_data.shrink_to_fit();
+    map.m_files.reserve(static_cast<std::size_t>(std::count_if(records.begin(), records.end(), [](const Record &record) { return record.isFile; })));
+    for (const auto &record : records) {
+        if (record.isFile) {
+            map.m_files.emplace_back(CompactArchiveFile{ view(record.nameOffset, record.nameSize), view(record.contentOffset, record.contentSize),
+                record.creationTime, record.modificationTime, record.type });
+        }
+    }
+    auto fileIndex = std::size_t();
+    for (auto record = records.begin(), end = records.end(); record != end;) {
+        const auto path = view(record->directoryOffset, record->directorySize);
+        auto &directory = map.m_directories.emplace_back(CompactArchiveDirectory{ path, map.m_files.data() + fileIndex, 0 });
+        for (; record != end && view(record->directoryOffset, record->directorySize) == path; ++record) {
+            directory.fileCount += record->isFile;
+        }
+        fileIndex += directory.fileCount;
+    }
+    map.m_directories.shrink_to_fit();
+    records.clear();
+    return std::move(map);
+}
+
 void walkThroughArchiveInternal(ArchiveHandle &ar, std::string_view archiveName, const FilePredicate &isFileRelevant, FileHandler &&fileHandler,
-    DirectoryHandler &&directoryHandler)
+    FileChunkHandler &&fileChunkHandler, DirectoryHandler &&directoryHandler)
 {
     // iterate through all archive entries
     struct archive_entry *const entry = archive_entry_new();
@@ -134,10 +276,45 @@ void walkThroughArchiveInternal(ArchiveHandle &ar, std::string_view archiveName,
         // read timestamps
         const auto creationTime = DateTime::fromTimeStampGmt(archive_entry_ctime(entry));
         const auto modificationTime = DateTime::fromTimeStampGmt(archive_entry_mtime(entry));
+        const auto directoryPath = std::string_view(filePath, static_cast<std::string::size_type>(dirEnd - filePath));
+
+        // pass file content chunk-wise to the chunk handler without buffering it
+        if (fileChunkHandler) {
+            const auto file = entryType == AE_IFLNK
+                ? ArchiveFile(fileName, std::string(archive_entry_symlink_utf8(entry)), ArchiveFileType::Link, creationTime, modificationTime)
+                : ArchiveFile(fileName, std::string(), ArchiveFileType::Regular, creationTime, modificationTime);
+            auto chunk = ArchiveFileChunk();
+            if (entryType == AE_IFREG) {
+                const void *buff;
+                auto size = std::size_t();
+                auto offset = la_int64_t();
+                for (;;) {
+                    const auto returnCode = archive_read_data_block(ar, &buff, &size, &offset);
+                    if (returnCode == ARCHIVE_EOF || returnCode < ARCHIVE_OK) {
+                        break;
+                    }
+                    if (!size) {
+                        continue;
+                    }
+                    chunk.data = std::string_view(static_cast<const char *>(buff), size);
+                    chunk.offset = static_cast<std::uint64_t>(offset);
+                    if (fileChunkHandler(directoryPath, file, chunk)) {
+                        goto free;
+                    }
+                    chunk.offset += size;
+                }
+            }
+            chunk.data = std::string_view();
+            chunk.isLast = true;
+            if (fileChunkHandler(directoryPath, file, chunk)) {
+                goto free;
+            }
+            continue;
+        }
 
         // read symlink
         if (entryType == AE_IFLNK) {
-            if (fileHandler(std::string_view(filePath, static_cast<std::string::size_type>(dirEnd - filePath)),
+            if (fileHandler(directoryPath,
                     ArchiveFile(fileName, std::string(archive_entry_symlink_utf8(entry)), ArchiveFileType::Link, creationTime, modificationTime))) {
                 goto free;
             }
@@ -164,8 +341,7 @@ void walkThroughArchiveInternal(ArchiveHandle &ar, std::string_view archiveName,
         }
 
         // move it to results
-        if (fileHandler(std::string_view(filePath, static_cast<std::string::size_type>(dirEnd - filePath)),
-                ArchiveFile(fileName, std::move(fileContent), ArchiveFileType::Regular, creationTime, modificationTime))) {
+        if (fileHandler(directoryPath, ArchiveFile(fileName, std::move(fileContent), ArchiveFileType::Regular, creationTime, modificationTime))) {
             goto free;
         }
     }
@@ -183,20 +359,13 @@ free:
     }
 }
 
-/// \endcond
-
-/*!
- * \brief Invokes callbacks for files and directories in the specified archive.
- */
-void walkThroughArchiveFromBuffer(std::string_view archiveData, std::string_view archiveName, const FilePredicate &isFileRelevant,
-    FileHandler &&fileHandler, DirectoryHandler &&directoryHandler)
+void openArchiveFromBuffer(ArchiveHandle &ar, std::string_view archiveData, std::string_view archiveName)
 {
     // refuse opening empty buffer
     if (archiveData.empty()) {
         throw ArchiveException("Unable to open archive \"" % archiveName + "\": archive data is empty");
     }
     // open archive buffer using libarchive
-    auto ar = ArchiveHandle();
     archive_read_support_filter_all(ar);
     archive_read_support_format_all(ar);
     const auto returnCode = archive_read_open_memory(ar, archiveData.data(), archiveData.size());
@@ -207,24 +376,9 @@ void walkThroughArchiveFromBuffer(std::string_view archiveData, std::string_view
             throw ArchiveException("Unable to open/read archive \"" % archiveName + "\": unable to open archive from memory");
         }
     }
-    walkThroughArchiveInternal(ar, archiveName, isFileRelevant, std::move(fileHandler), std::move(directoryHandler));
-}
-
-/*!
- * \brief Extracts the specified archive.
- */
-FileMap extractFilesFromBuffer(std::string_view archiveData, std::string_view archiveName, const FilePredicate &isFileRelevant)
-{
-    auto results = FileMap();
-    walkThroughArchiveFromBuffer(archiveData, archiveName, isFileRelevant, AddFileToFileMap{ results }, AddDirectoryToFileMap{ results });
-    return results;
 }
 
-/*!
- * \brief Invokes callbacks for files and directories in the specified archive.
- */
-void walkThroughArchive(
-    std::string_view archivePath, const FilePredicate &isFileRelevant, FileHandler &&fileHandler, DirectoryHandler &&directoryHandler)
+void openArchiveFromFile(ArchiveHandle &ar, std::string_view archivePath)
 {
     // open archive file using libarchive
     if (archivePath.empty()) {
@@ -238,7 +392,6 @@ void walkThroughArchive(
     if (!size) {
         throw ArchiveException("Unable to open archive \"" % archivePath + "\": file is empty");
     }
-    auto ar = ArchiveHandle();
     archive_read_support_filter_all(ar);
     archive_read_support_format_all(ar);
     const auto returnCode = archive_read_open_filename(ar, archivePath.data(), 10240);
@@ -249,7 +402,579 @@ void walkThroughArchive(
             throw ArchiveException("Unable to open/read archive \"" % archivePath + "\": unable to open archive from file");
         }
     }
-    walkThroughArchiveInternal(ar, archivePath, isFileRelevant, std::move(fileHandler), std::move(directoryHandler));
+}
+
+void walkThroughArchiveHeadersInternal(ArchiveHandle &ar, std::string_view archiveName, ArchiveEntryHandler &&entryHandler)
+{
+    // iterate through all archive entries skipping their data
+    struct archive_entry *const entry = archive_entry_new();
+    auto info = ArchiveEntry();
+    while (archive_read_next_header2(ar, entry) == ARCHIVE_OK) {
+        // check entry type (only dirs, files and symlinks relevant here)
+        switch (archive_entry_filetype(entry)) {
+        case AE_IFREG:
+            info.type = ArchiveEntryType::Regular;
+            break;
+        case AE_IFLNK:
+            info.type = ArchiveEntryType::Link;
+            break;
+        case AE_IFDIR:
+            info.type = ArchiveEntryType::Directory;
+            break;
+        default:
+            archive_read_data_skip(ar);
+            continue;
+        }
+
+        // get file path
+        const char *filePath = archive_entry_pathname_utf8(entry);
+        if (!filePath) {
+            filePath = archive_entry_pathname(entry);
+        }
+        if (!filePath) {
+            archive_read_data_skip(ar);
+            continue;
+        }
+        info.path = filePath;
+        if (info.type == ArchiveEntryType::Directory) {
+            // remove trailing slashes
+            for (; !info.path.empty() && info.path.back() == '/'; info.path.remove_suffix(1))
+                ;
+        }
+
+        // get metadata
+        const auto size = archive_entry_size(entry);
+        info.size = info.type != ArchiveEntryType::Directory && size > 0 ? static_cast<std::uint64_t>(size) : 0;
+        info.modificationTime = DateTime::fromTimeStampGmt(archive_entry_mtime(entry));
+        info.permissions = archive_entry_perm(entry);
+        if (entryHandler(info)) {
+            break;
+        }
+
+        // skip data without decompressing it (if supported by the format)
+        if (archive_read_data_skip(ar) < ARCHIVE_WARN) {
+            break;
+        }
+    }
+
+    // check for errors
+    const auto *const archiveError = archive_error_string(ar);
+    const auto errorMessage = archiveError ? std::string(archiveError) : std::string();
+
+    // free resources used by libarchive
+    archive_entry_free(entry);
+    ar.close(archiveName, errorMessage);
+    if (archiveError) {
+        throw ArchiveException(argsToString("An error occurred when reading archive \"", archiveName, "\": ", errorMessage));
+    }
+}
+
+/// \brief Feeds an archive file to libarchive via NativeFileStream without providing a seek callback.
+/// \remarks This makes libarchive use streaming readers (e.g. for Zip) so header positions are offsets within the file and
+///          reading can start at such an offset.
+struct ArchiveFileSource {
+    static la_ssize_t read(struct archive *, void *clientData, const void **buffer);
+    static la_int64_t skip(struct archive *, void *clientData, la_int64_t request);
+
+    NativeFileStream file;
+    std::vector<char> buffer = std::vector<char>(64 * 1024);
+};
+
+la_ssize_t ArchiveFileSource::read(struct archive *, void *clientData, const void **buffer)
+{
+    auto &source = *static_cast<ArchiveFileSource *>(clientData);
+    *buffer = source.buffer.data();
+    return static_cast<la_ssize_t>(source.file.rdbuf()->sgetn(source.buffer.data(), static_cast<std::streamsize>(source.buffer.size())));
+}
+
+la_int64_t ArchiveFileSource::skip(struct archive *, void *clientData, la_int64_t request)
+{
+    auto &source = *static_cast<ArchiveFileSource *>(clientData);
+    return source.file.rdbuf()->pubseekoff(request, std::ios_base::cur, std::ios_base::in) == std::streampos(-1) ? 0 : request;
+}
+
+/// \brief Opens the archive at \a archivePath starting at \a offset via \a source.
+/// \remarks \a source must outlive \a ar as libarchive reads from it until \a ar is closed (also when \a ar is destroyed).
+void openArchiveFromFileAtOffset(ArchiveHandle &ar, ArchiveFileSource &source, const std::string &archivePath, std::uint64_t offset)
+{
+    try {
+        source.file.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+        source.file.open(archivePath, std::ios_base::in | std::ios_base::binary);
+        source.file.seekg(static_cast<std::streamoff>(offset));
+        source.file.exceptions(std::ios_base::goodbit);
+    } catch (const std::ios_base::failure &failure) {
+        throw ArchiveException("Unable to open archive \"" % archivePath % "\": " + failure.what());
+    }
+    archive_read_support_filter_all(ar);
+    archive_read_support_format_all(ar);
+    if (archive_read_open2(ar, &source, nullptr, &ArchiveFileSource::read, &ArchiveFileSource::skip, nullptr) != ARCHIVE_OK) {
+        const char *const error = archive_error_string(ar);
+        throw ArchiveException("Unable to open/read archive \"" % archivePath % "\": " + (error ? error : "unable to open archive from file"));
+    }
+}
+
+/// \brief Returns the path of the specified \a entry if it is a directory, regular file or symlink; otherwise returns nullptr.
+const char *indexablePath(struct archive_entry *entry, ArchiveEntryType &type)
+{
+    switch (archive_entry_filetype(entry)) {
+    case AE_IFREG:
+        type = ArchiveEntryType::Regular;
+        break;
+    case AE_IFLNK:
+        type = ArchiveEntryType::Link;
+        break;
+    case AE_IFDIR:
+        type = ArchiveEntryType::Directory;
+        break;
+    default:
+        return nullptr;
+    }
+    const auto *const path = archive_entry_pathname_utf8(entry);
+    return path ? path : archive_entry_pathname(entry);
+}
+
+/// \brief Returns \a path without trailing slashes.
+std::string_view withoutTrailingSlashes(std::string_view path)
+{
+    for (; !path.empty() && path.back() == '/'; path.remove_suffix(1))
+        ;
+    return path;
+}
+
+/// \brief Reads the data of the current entry of \a ar into an ArchiveFile.
+ArchiveFile readArchiveFile(ArchiveHandle &ar, struct archive_entry *entry, std::string_view path, ArchiveEntryType type)
+{
+    const auto fileName = path.substr(path.rfind('/') + 1);
+    const auto creationTime = DateTime::fromTimeStampGmt(archive_entry_ctime(entry));
+    const auto modificationTime = DateTime::fromTimeStampGmt(archive_entry_mtime(entry));
+    if (type == ArchiveEntryType::Link) {
+        return ArchiveFile(std::string(fileName), std::string(archive_entry_symlink_utf8(entry)), ArchiveFileType::Link, creationTime, modificationTime);
+    }
+    auto content = std::string();
+    if (const auto fileSize = archive_entry_size(entry); fileSize > 0) {
+        content.reserve(static_cast<std::string::size_type>(fileSize));
+    }
+    const void *buff;
+    auto size = std::size_t();
+    auto offset = la_int64_t();
+    for (;;) {
+        const auto returnCode = archive_read_data_block(ar, &buff, &size, &offset);
+        if (returnCode == ARCHIVE_EOF) {
+            break;
+        }
+        if (returnCode < ARCHIVE_OK) {
+            const char *const error = archive_error_string(ar);
+            throw ArchiveException("Unable to read \"" % path % "\": " + (error ? error : "unable to read data"));
+        }
+        content.append(static_cast<const char *>(buff), size);
+    }
+    return ArchiveFile(std::string(fileName), std::move(content), ArchiveFileType::Regular, creationTime, modificationTime);
+}
+
+/// \brief Frees \a entry when going out of scope.
+struct ArchiveEntryGuard {
+    ~ArchiveEntryGuard()
+    {
+        archive_entry_free(entry);
+    }
+    struct archive_entry *entry;
+};
+
+/// \brief A unit of work for walkThroughArchivesInParallel(): a whole archive or one bucket of the files of a Zip archive.
+struct ArchiveWorkItem {
+    std::size_t archiveIndex = 0;
+    std::size_t bucket = 0;
+    std::size_t bucketCount = 1;
+    std::shared_ptr<const std::vector<std::size_t>> owners; // the bucket of each file; null if the whole archive is a single item
+    std::uint64_t cost = 0;
+};
+
+/// \brief A file extracted by a worker; \a file is not set if the file was not relevant.
+struct ExtractedFile {
+    std::string directoryPath;
+    std::optional<ArchiveFile> file;
+};
+
+/// \brief The files extracted for an ArchiveWorkItem, buffered to invoke the handler in order.
+struct ExtractedFiles {
+    std::deque<ExtractedFile> files;
+    std::exception_ptr error;
+    bool done = false;
+};
+
+/// \brief Returns the size of each file within the specified Zip archive or an empty vector if it is not a seekable Zip archive.
+/// \remarks Skipping file contents is cheap for those archives as libarchive can seek to the next file via the central directory.
+std::vector<std::uint64_t> listFileSizesOfZipArchive(const std::string &archivePath)
+{
+    auto sizes = std::vector<std::uint64_t>();
+    try {
+        auto ar = ArchiveHandle();
+        openArchiveFromFile(ar, archivePath);
+        struct archive_entry *const entry = archive_entry_new();
+        while (archive_read_next_header2(ar, entry) == ARCHIVE_OK) {
+            if ((archive_format(ar) & ARCHIVE_FORMAT_BASE_MASK) != ARCHIVE_FORMAT_ZIP || archive_filter_count(ar) > 1) {
+                sizes.clear();
+                break;
+            }
+            // count the same entries as walkThroughArchiveInternal() passes to the FilePredicate
+            const auto entryType(archive_entry_filetype(entry));
+            if ((entryType != AE_IFREG && entryType != AE_IFLNK) || (!archive_entry_pathname_utf8(entry) && !archive_entry_pathname(entry))) {
+                continue;
+            }
+            const auto size = archive_entry_size(entry);
+            sizes.emplace_back(size > 0 ? static_cast<std::uint64_t>(size) : 0);
+        }
+        if (archive_errno(ar)) {
+            sizes.clear();
+        }
+        archive_entry_free(entry);
+    } catch (const ArchiveException &) {
+        // let the worker report the error when processing the archive as a whole
+        sizes.clear();
+    }
+    return sizes;
+}
+
+/// \brief Adds work items for the specified archive, distributing the files of Zip archives by size over up to \a maxBuckets items.
+void addArchiveWorkItems(std::vector<ArchiveWorkItem> &items, const std::string &archivePath, std::size_t archiveIndex, std::size_t maxBuckets)
+{
+    const auto fileSizes = maxBuckets > 1 ? listFileSizesOfZipArchive(archivePath) : std::vector<std::uint64_t>();
+    const auto bucketCount = std::min(maxBuckets, fileSizes.size());
+    if (bucketCount < 2) {
+        auto ec = std::error_code();
+        const auto archiveSize = std::filesystem::file_size(archivePath, ec);
+        items.emplace_back(ArchiveWorkItem{ archiveIndex, 0, 1, nullptr, ec ? 0 : static_cast<std::uint64_t>(archiveSize) });
+        return;
+    }
+
+    // assign the biggest remaining file to the bucket with the least total size so far
+    auto order = std::vector<std::size_t>(fileSizes.size());
+    std::iota(order.begin(), order.end(), std::size_t());
+    std::stable_sort(order.begin(), order.end(), [&fileSizes](std::size_t lhs, std::size_t rhs) { return fileSizes[lhs] > fileSizes[rhs]; });
+    auto owners = std::make_shared<std::vector<std::size_t>>(fileSizes.size());
+    const auto firstItem = items.size();
+    for (auto bucket = std::size_t(); bucket != bucketCount; ++bucket) {
+        items.emplace_back(ArchiveWorkItem{ archiveIndex, bucket, bucketCount, owners, 0 });
+    }
+    for (const auto fileIndex : order) {
+        auto &item = *std::min_element(items.begin() + static_cast<std::ptrdiff_t>(firstItem), items.end(),
+            [](const ArchiveWorkItem &lhs, const ArchiveWorkItem &rhs) { return lhs.cost < rhs.cost; });
+        item.cost += fileSizes[fileIndex];
+        (*owners)[fileIndex] = item.bucket;
+    }
+}
+
+/// \brief Holds the state shared between the workers of walkThroughArchivesInParallel() and the calling thread.
+struct ParallelArchiveWalk {
+    /// \brief The number of bytes of files extracted ahead of time which may be buffered when preserving the order.
+    static constexpr auto maxBufferedSize = std::size_t(64 * 1024 * 1024);
+
+    void work();
+    void processItem(std::size_t itemIndex);
+    void pushFile(std::size_t itemIndex, ExtractedFile &&file);
+    std::optional<ExtractedFile> popFile(std::size_t itemIndex);
+    void dispatch();
+    void abort();
+
+    const std::vector<std::string> &archivePaths;
+    const FilePredicate &isFileRelevant;
+    const ArchiveFileHandler &fileHandler;
+    const DirectoryHandler &directoryHandler;
+    const bool preserveOrder;
+    std::vector<ArchiveWorkItem> items;
+    std::vector<std::size_t> schedule;
+    std::vector<ExtractedFiles> results;
+    std::atomic<std::size_t> nextScheduledItem = 0;
+    std::atomic<bool> aborted = false;
+    std::mutex mutex;
+    std::condition_variable fileAvailable;
+    std::condition_variable spaceAvailable;
+    std::size_t bufferedSize = 0;
+    std::size_t firstDispatchedItem = 0;
+    std::size_t endOfDispatchedItems = 0;
+    std::exception_ptr error;
+};
+
+/// \brief Returns the number of bytes the specified \a file occupies when buffered.
+static std::size_t bufferedSizeOf(const ExtractedFile &file)
+{
+    return sizeof(ExtractedFile) + file.directoryPath.size() + (file.file ? file.file->name.size() + file.file->content.size() : 0);
+}
+
+/// \brief Processes work items until all items have been processed or the walk has been aborted.
+void ParallelArchiveWalk::work()
+{
+    for (auto next = nextScheduledItem++; next < schedule.size() && !aborted.load(); next = nextScheduledItem++) {
+        processItem(schedule[next]);
+    }
+}
+
+/// \brief Extracts the files of the specified item; invokes the file handler directly or buffers the files if the order is preserved.
+void ParallelArchiveWalk::processItem(std::size_t itemIndex)
+{
+    const auto &item = items[itemIndex];
+    const auto &archivePath = archivePaths[item.archiveIndex];
+    auto *const itemResults = preserveOrder ? &results[itemIndex] : nullptr;
+    auto fileIndex = std::size_t();
+    const auto isRelevant = FilePredicate([&](const char *filePath, const char *fileName, mode_t mode) {
+        if (item.owners && (fileIndex >= item.owners->size() || (*item.owners)[fileIndex++] != item.bucket)) {
+            return false;
+        }
+        if (aborted.load()) {
+            return false;
+        }
+        if (!isFileRelevant || isFileRelevant(filePath, fileName, mode)) {
+            return true;
+        }
+        if (itemResults && item.owners) {
+            pushFile(itemIndex, ExtractedFile()); // let dispatch() know the file has been skipped
+        }
+        return false;
+    });
+    auto handleFile = [&](std::string_view directoryPath, ArchiveFile &&file) {
+        if (itemResults) {
+            pushFile(itemIndex, ExtractedFile{ std::string(directoryPath), std::move(file) });
+        } else if (fileHandler && fileHandler(archivePath, directoryPath, std::move(file))) {
+            aborted = true;
+        }
+        return aborted.load();
+    };
+    auto handleDirectory = DirectoryHandler();
+    if (directoryHandler && !item.bucket) {
+        handleDirectory = [this](std::string_view directoryPath) {
+            const auto lock = std::lock_guard<std::mutex>(mutex);
+            return directoryHandler(directoryPath) || aborted.load();
+        };
+    }
+    try {
+        auto ar = ArchiveHandle();
+        openArchiveFromFile(ar, archivePath);
+        walkThroughArchiveInternal(ar, archivePath, isRelevant, std::move(handleFile), FileChunkHandler(), std::move(handleDirectory));
+    } catch (...) {
+        const auto lock = std::lock_guard<std::mutex>(mutex);
+        if (itemResults) {
+            itemResults->error = std::current_exception();
+        } else if (!error) {
+            error = std::current_exception();
+            aborted = true;
+        }
+    }
+    if (itemResults) {
+        auto lock = std::unique_lock<std::mutex>(mutex);
+        itemResults->done = true;
+        lock.unlock();
+        fileAvailable.notify_one();
+    }
+}
+
+/// \brief Buffers the specified \a file of the specified item for dispatch().
+/// \remarks Waits until dispatch() has caught up if maxBufferedSize would be exceeded. Files of the archive currently being
+///          dispatched are always buffered so dispatch() can not end up waiting for a worker waiting for dispatch().
+void ParallelArchiveWalk::pushFile(std::size_t itemIndex, ExtractedFile &&file)
+{
+    const auto size = bufferedSizeOf(file);
+    auto lock = std::unique_lock<std::mutex>(mutex);
+    spaceAvailable.wait(lock, [&] {
+        return !bufferedSize || bufferedSize + size <= maxBufferedSize || (itemIndex >= firstDispatchedItem && itemIndex < endOfDispatchedItems)
+            || aborted.load();
+    });
+    bufferedSize += size;
+    results[itemIndex].files.emplace_back(std::move(file));
+    lock.unlock();
+    fileAvailable.notify_one();
+}
+
+/// \brief Waits for the next file of the specified item; returns std::nullopt if there are no further files.
+/// \throws Rethrows the exception which occurred when processing the item.
+std::optional<ExtractedFile> ParallelArchiveWalk::popFile(std::size_t itemIndex)
+{
+    auto &itemResults = results[itemIndex];
+    auto lock = std::unique_lock<std::mutex>(mutex);
+    fileAvailable.wait(lock, [&itemResults] { return !itemResults.files.empty() || itemResults.done; });
+    if (itemResults.files.empty()) {
+        if (itemResults.error) {
+            std::rethrow_exception(itemResults.error);
+        }
+        return std::nullopt;
+    }
+    auto file = std::make_optional(std::move(itemResults.files.front()));
+    itemResults.files.pop_front();
+    bufferedSize -= bufferedSizeOf(*file);
+    lock.unlock();
+    spaceAvailable.notify_all();
+    return file;
+}
+
+/// \brief Invokes the file handler for the buffered files in the order of the archives and the files within them.
+void ParallelArchiveWalk::dispatch()
+{
+    const auto handle = [this](const ArchiveWorkItem &item, ExtractedFile &file) {
+        if (file.file && fileHandler && fileHandler(archivePaths[item.archiveIndex], file.directoryPath, std::move(*file.file))) {
+            abort();
+        }
+        return aborted.load();
+    };
+    for (auto itemIndex = std::size_t(); itemIndex < items.size(); itemIndex += items[itemIndex].bucketCount) {
+        const auto &item = items[itemIndex];
+        auto lock = std::unique_lock<std::mutex>(mutex);
+        firstDispatchedItem = itemIndex;
+        endOfDispatchedItems = itemIndex + item.bucketCount;
+        lock.unlock();
+        spaceAvailable.notify_all();
+        if (!item.owners) {
+            while (auto file = popFile(itemIndex)) {
+                if (handle(item, *file)) {
+                    return;
+                }
+            }
+            continue;
+        }
+        // take the files of split archives from the bucket they have been assigned to
+        for (const auto bucket : *item.owners) {
+            auto file = popFile(itemIndex + bucket);
+            if (!file) {
+                break;
+            }
+            if (handle(item, *file)) {
+                return;
+            }
+        }
+        for (auto bucket = std::size_t(); bucket != item.bucketCount; ++bucket) {
+            while (popFile(itemIndex + bucket)) {
+            }
+        }
+    }
+}
+
+/// \brief Aborts the walk waking up workers waiting for dispatch().
+void ParallelArchiveWalk::abort()
+{
+    auto lock = std::unique_lock<std::mutex>(mutex);
+    aborted = true;
+    lock.unlock();
+    spaceAvailable.notify_all();
+}
+
+/// \brief Implements walkThroughArchivesInParallel() and extractFilesInParallel().
+void walkThroughArchivesInParallelInternal(const std::vector<std::string> &archivePaths, const FilePredicate &isFileRelevant,
+    const ArchiveFileHandler &fileHandler, const DirectoryHandler &directoryHandler, ParallelArchiveFlags flags, unsigned int threadCount)
+{
+    if (!threadCount) {
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    auto walk = ParallelArchiveWalk{ archivePaths, isFileRelevant, fileHandler, directoryHandler, flags && ParallelArchiveFlags::PreserveOrder };
+    for (auto archiveIndex = std::size_t(); archiveIndex != archivePaths.size(); ++archiveIndex) {
+        addArchiveWorkItems(walk.items, archivePaths[archiveIndex], archiveIndex, threadCount);
+    }
+    if (walk.items.empty()) {
+        return;
+    }
+
+    // process the most expensive items first to balance the load unless the order is preserved; then the items are processed
+    // in order so the items dispatch() waits for are always being processed and not much needs to be buffered
+    walk.schedule.resize(walk.items.size());
+    std::iota(walk.schedule.begin(), walk.schedule.end(), std::size_t());
+    if (walk.preserveOrder) {
+        walk.results.resize(walk.items.size());
+    } else {
+        std::stable_sort(walk.schedule.begin(), walk.schedule.end(),
+            [&items = walk.items](std::size_t lhs, std::size_t rhs) { return items[lhs].cost > items[rhs].cost; });
+    }
+
+    struct JoinThreads {
+        ~JoinThreads()
+        {
+            for (auto &thread : threads) {
+                thread.join();
+            }
+        }
+        std::vector<std::thread> threads;
+    } workers;
+    try {
+        const auto workerCount = std::min<std::size_t>(threadCount, walk.items.size());
+        workers.threads.reserve(workerCount);
+        for (auto i = std::size_t(); i != workerCount; ++i) {
+            workers.threads.emplace_back(&ParallelArchiveWalk::work, &walk);
+        }
+        if (walk.preserveOrder) {
+            walk.dispatch();
+        }
+    } catch (...) {
+        walk.abort();
+        throw;
+    }
+    for (auto &thread : workers.threads) {
+        thread.join();
+    }
+    workers.threads.clear();
+    if (walk.error) {
+        std::rethrow_exception(walk.error);
+    }
+}
+
+/// \endcond
+
+/*!
+ * \brief Invokes callbacks for files and directories in the specified archive.
+ */
+void walkThroughArchiveFromBuffer(std::string_view archiveData, std::string_view archiveName, const FilePredicate &isFileRelevant,
+    FileHandler &&fileHandler, DirectoryHandler &&directoryHandler)
+{
+    auto ar = ArchiveHandle();
+    openArchiveFromBuffer(ar, archiveData, archiveName);
+    walkThroughArchiveInternal(ar, archiveName, isFileRelevant, std::move(fileHandler), FileChunkHandler(), std::move(directoryHandler));
+}
+
+/*!
+ * \brief Invokes callbacks for files and directories in the specified archive passing file contents chunk-wise.
+ * \remarks See streamThroughArchive() for details.
+ */
+void streamThroughArchiveFromBuffer(std::string_view archiveData, std::string_view archiveName, const FilePredicate &isFileRelevant,
+    FileChunkHandler &&fileChunkHandler, DirectoryHandler &&directoryHandler)
+{
+    auto ar = ArchiveHandle();
+    openArchiveFromBuffer(ar, archiveData, archiveName);
+    walkThroughArchiveInternal(ar, archiveName, isFileRelevant, FileHandler(), std::move(fileChunkHandler), std::move(directoryHandler));
+}
+
+/*!
+ * \brief Extracts the specified archive.
+ */
+FileMap extractFilesFromBuffer(std::string_view archiveData, std::string_view archiveName, const FilePredicate &isFileRelevant)
+{
+    auto results = FileMap();
+    walkThroughArchiveFromBuffer(archiveData, archiveName, isFileRelevant, AddFileToFileMap{ results }, AddDirectoryToFileMap{ results });
+    return results;
+}
+
+/*!
+ * \brief Invokes callbacks for files and directories in the specified archive.
+ */
+void walkThroughArchive(
+    std::string_view archivePath, const FilePredicate &isFileRelevant, FileHandler &&fileHandler, DirectoryHandler &&directoryHandler)
+{
+    auto ar = ArchiveHandle();
+    openArchiveFromFile(ar, archivePath);
+    walkThroughArchiveInternal(ar, archivePath, isFileRelevant, std::move(fileHandler), FileChunkHandler(), std::move(directoryHandler));
+}
+
+/*!
+ * \brief Invokes callbacks for files and directories in the specified archive passing file contents chunk-wise.
+ * \remarks
+ * - In contrast to walkThroughArchive(), the content of a file is not buffered. Instead, \a fileChunkHandler is invoked for
+ *   each chunk as soon as it has been decoded. So files can be hashed, searched or copied in constant memory regardless of
+ *   their size.
+ * - The ArchiveFile passed to \a fileChunkHandler has an empty content (except for symlinks where it contains the target).
+ * - \a fileChunkHandler is invoked a last time for each file with ArchiveFileChunk::isLast set (and empty data). For empty
+ *   files and symlinks, this is the only invocation.
+ * - If \a fileChunkHandler or \a directoryHandler returns true, the iteration is aborted.
+ */
+void streamThroughArchive(
+    std::string_view archivePath, const FilePredicate &isFileRelevant, FileChunkHandler &&fileChunkHandler, DirectoryHandler &&directoryHandler)
+{
+    auto ar = ArchiveHandle();
+    openArchiveFromFile(ar, archivePath);
+    walkThroughArchiveInternal(ar, archivePath, isFileRelevant, FileHandler(), std::move(fileChunkHandler), std::move(directoryHandler));
 }
 
 /*!
@@ -262,4 +987,555 @@ FileMap extractFiles(std::string_view archivePath, const FilePredicate &isFileRe
     return results;
 }
 
+/*!
+ * \class MappedArchive
+ * \brief The MappedArchive class maps an archive file into memory so it can be read without copying it into a buffer first.
+ *
+ * The walkThroughArchive() and streamThroughArchive() overloads taking a MappedArchive feed the mapping directly to
+ * libarchive's memory reader. When using streamThroughArchive(), chunks of stored (uncompressed) members usually point
+ * directly into the mapping. Use contains() to check whether that is the case for a particular chunk. If so, the chunk
+ * can be kept as std::string_view without copying it as long as the MappedArchive exists.
+ */
+
+/*!
+ * \brief Maps the archive at the specified \a archivePath read-only into memory.
+ * \throws Throws ArchiveException if the archive can not be mapped or is empty.
+ */
+MappedArchive::MappedArchive(std::string_view archivePath)
+    : m_path(archivePath)
+    , m_data(nullptr)
+    , m_size(0)
+#ifdef PLATFORM_WINDOWS
+    , m_mappingHandle(nullptr)
+#endif
+{
+    if (m_path.empty()) {
+        throw ArchiveException("Unable to open archive: no path specified");
+    }
+#if defined(PLATFORM_UNIX)
+    const auto fd = ::open(m_path.data(), O_RDONLY);
+    if (fd == -1) {
+        throw ArchiveException("Unable to open archive \"" % m_path % "\": " + std::error_code(errno, std::system_category()).message());
+    }
+    struct stat fileInfo;
+    if (::fstat(fd, &fileInfo) == -1) {
+        const auto error = errno;
+        ::close(fd);
+        throw ArchiveException("Unable to determine size of \"" % m_path % "\": " + std::error_code(error, std::system_category()).message());
+    }
+    if (fileInfo.st_size <= 0) {
+        ::close(fd);
+        throw ArchiveException("Unable to open archive \"" % m_path + "\": file is empty");
+    }
+    m_size = static_cast<std::size_t>(fileInfo.st_size);
+    auto *const mapping = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    const auto error = errno;
+    ::close(fd); // the mapping stays valid after closing the file descriptor
+    if (mapping == MAP_FAILED) {
+        throw ArchiveException("Unable to map archive \"" % m_path % "\": " + std::error_code(error, std::system_category()).message());
+    }
+    ::madvise(mapping, m_size, MADV_SEQUENTIAL);
+    m_data = static_cast<const char *>(mapping);
+#elif defined(PLATFORM_WINDOWS)
+    auto ec = std::error_code();
+    const auto widePath = convertMultiByteToWide(ec, std::string_view(m_path));
+    if (ec) {
+        throw ArchiveException("Unable to open archive \"" % m_path % "\": " + ec.message());
+    }
+    const auto file = CreateFileW(widePath.data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw ArchiveException("Unable to open archive \"" % m_path % "\": " + std::error_code(static_cast<int>(GetLastError()), std::system_category()).message());
+    }
+    auto size = LARGE_INTEGER();
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+        CloseHandle(file);
+        throw ArchiveException("Unable to open archive \"" % m_path + "\": file is empty or its size can not be determined");
+    }
+    m_size = static_cast<std::size_t>(size.QuadPart);
+    m_mappingHandle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file); // the mapping keeps the file open
+    if (!m_mappingHandle) {
+        throw ArchiveException("Unable to map archive \"" % m_path % "\": " + std::error_code(static_cast<int>(GetLastError()), std::system_category()).message());
+    }
+    m_data = static_cast<const char *>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (!m_data) {
+        const auto error = GetLastError();
+        CloseHandle(m_mappingHandle);
+        throw ArchiveException("Unable to map archive \"" % m_path % "\": " + std::error_code(static_cast<int>(error), std::system_category()).message());
+    }
+#else
+    throw ArchiveException("Unable to map archive \"" % m_path + "\": not supported on this platform");
+#endif
+}
+
+/*!
+ * \brief Moves the mapping from \a other to the new object.
+ */
+MappedArchive::MappedArchive(MappedArchive &&other) noexcept
+    : m_path(std::move(other.m_path))
+    , m_data(std::exchange(other.m_data, nullptr))
+    , m_size(std::exchange(other.m_size, 0))
+#ifdef PLATFORM_WINDOWS
+    , m_mappingHandle(std::exchange(other.m_mappingHandle, nullptr))
+#endif
+{
+}
+
+/*!
+ * \brief Unmaps the archive. All string views pointing into the mapping are invalidated.
+ */
+MappedArchive::~MappedArchive()
+{
+    if (!m_data) {
+        return;
+    }
+#if defined(PLATFORM_UNIX)
+    ::munmap(const_cast<char *>(m_data), m_size);
+#elif defined(PLATFORM_WINDOWS)
+    UnmapViewOfFile(m_data);
+    CloseHandle(m_mappingHandle);
+#endif
+}
+
+/*!
+ * \brief Invokes callbacks for files and directories in the specified mapped archive.
+ * \remarks Reads the archive directly from the mapping. See walkThroughArchive() for details.
+ */
+void walkThroughArchive(const MappedArchive &archive, const FilePredicate &isFileRelevant, FileHandler &&fileHandler, DirectoryHandler &&directoryHandler)
+{
+    walkThroughArchiveFromBuffer(archive.data(), archive.path(), isFileRelevant, std::move(fileHandler), std::move(directoryHandler));
+}
+
+/*!
+ * \brief Invokes callbacks for files and directories in the specified mapped archive passing file contents chunk-wise.
+ * \remarks
+ * - Reads the archive directly from the mapping. See streamThroughArchive() for details.
+ * - Chunks of stored (uncompressed) members usually point directly into the mapping (see MappedArchive::contains()).
+ */
+void streamThroughArchive(
+    const MappedArchive &archive, const FilePredicate &isFileRelevant, FileChunkHandler &&fileChunkHandler, DirectoryHandler &&directoryHandler)
+{
+    streamThroughArchiveFromBuffer(archive.data(), archive.path(), isFileRelevant, std::move(fileChunkHandler), std::move(directoryHandler));
+}
+
+/*!
+ * \class ArchiveIndex
+ * \brief The ArchiveIndex class records the entries of an archive and their location to extract single files quickly.
+ *
+ * Extracting a single file via walkThroughArchive() requires reading (and decompressing) the archive from the start. Once an
+ * index has been built via build(), extractFile() jumps directly to the header of the requested file if the archive is
+ * seekable (see isSeekable()). Otherwise it still has to read the archive sequentially but stops at the requested file.
+ *
+ * The index can be persisted via save() and loaded again via load(). An index is only loaded if the size and modification
+ * time of the archive have not changed. loadOrBuild() combines both.
+ */
+
+/*!
+ * \brief Builds the index for the archive at the specified \a archivePath by reading all headers.
+ * \throws Throws ArchiveException if the archive can not be read.
+ */
+ArchiveIndex ArchiveIndex::build(std::string_view archivePath)
+{
+    auto index = ArchiveIndex();
+    index.m_archivePath = archivePath;
+    auto ec = std::error_code();
+    index.m_archiveSize = std::filesystem::file_size(index.m_archivePath, ec);
+    if (!ec) {
+        index.m_archiveModificationTime = static_cast<std::int64_t>(std::filesystem::last_write_time(index.m_archivePath, ec).time_since_epoch().count());
+    }
+    if (ec) {
+        throw ArchiveException("Unable to determine size/modification time of \"" % archivePath % "\": " + ec.message());
+    }
+
+    auto source = ArchiveFileSource();
+    auto ar = ArchiveHandle();
+    openArchiveFromFileAtOffset(ar, source, index.m_archivePath, 0);
+    const auto entryGuard = ArchiveEntryGuard{ archive_entry_new() };
+    auto type = ArchiveEntryType::Regular;
+    while (archive_read_next_header2(ar, entryGuard.entry) == ARCHIVE_OK) {
+        if (index.m_entries.empty()) {
+            // jumping to headers is only possible for uncompressed formats which can be read from any header on
+            const auto format = archive_format(ar) & ARCHIVE_FORMAT_BASE_MASK;
+            index.m_isSeekable = archive_filter_count(ar) == 1
+                && (format == ARCHIVE_FORMAT_TAR || format == ARCHIVE_FORMAT_ZIP || format == ARCHIVE_FORMAT_CPIO);
+        }
+        if (const auto *const path = indexablePath(entryGuard.entry, type)) {
+            auto &entry = index.m_entries.emplace_back();
+            entry.path = type == ArchiveEntryType::Directory ? withoutTrailingSlashes(path) : std::string_view(path);
+            entry.headerOffset = static_cast<std::uint64_t>(archive_read_header_position(ar));
+            const auto size = archive_entry_size(entryGuard.entry);
+            entry.size = type != ArchiveEntryType::Directory && size > 0 ? static_cast<std::uint64_t>(size) : 0;
+            entry.modificationTime = DateTime::fromTimeStampGmt(archive_entry_mtime(entryGuard.entry));
+            entry.permissions = archive_entry_perm(entryGuard.entry);
+            entry.type = type;
+        }
+        if (archive_read_data_skip(ar) < ARCHIVE_WARN) {
+            break;
+        }
+    }
+    if (const char *const error = archive_error_string(ar)) {
+        throw ArchiveException(argsToString("An error occurred when reading archive \"", archivePath, "\": ", error));
+    }
+    index.sortEntriesByPath();
+    return index;
+}
+
+/*!
+ * \brief Returns the path the index for the archive at \a archivePath is persisted at by default.
+ */
+std::string ArchiveIndex::defaultIndexPath(std::string_view archivePath)
+{
+    return argsToString(archivePath, ".index");
+}
+
+/// \cond
+/// \brief The minimum number of bytes an entry occupies within a persisted index (path size, offset, size, time, permissions, type).
+constexpr auto minArchiveIndexEntrySize = std::uint64_t(1 + 8 + 8 + 8 + 4 + 1);
+/// \endcond
+
+/*!
+ * \brief Loads the index for the archive at \a archivePath from \a indexPath (defaults to defaultIndexPath()).
+ * \throws Throws ArchiveException if the index can not be read, is corrupted or is outdated.
+ */
+ArchiveIndex ArchiveIndex::load(std::string_view archivePath, std::string_view indexPath)
+{
+    auto index = ArchiveIndex();
+    index.m_archivePath = archivePath;
+    const auto path = indexPath.empty() ? defaultIndexPath(archivePath) : std::string(indexPath);
+    try {
+        auto file = NativeFileStream();
+        file.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+        file.open(path, std::ios_base::in | std::ios_base::binary);
+        auto reader = BinaryReader(&file);
+        if (reader.readString(26) != "c++utilities-archive-index" || reader.readByte() != 1) {
+            throw ArchiveException("Unable to load archive index \"" % path + "\": unknown format");
+        }
+        index.m_archiveSize = reader.readUInt64LE();
+        index.m_archiveModificationTime = reader.readInt64LE();
+        index.m_isSeekable = reader.readBool();
+        auto ec = std::error_code();
+        const auto archiveSize = std::filesystem::file_size(index.m_archivePath, ec);
+        const auto archiveModificationTime = ec ? 0 : std::filesystem::last_write_time(index.m_archivePath, ec).time_since_epoch().count();
+        if (ec || archiveSize != index.m_archiveSize || archiveModificationTime != index.m_archiveModificationTime) {
+            throw ArchiveException("Unable to load archive index \"" % path + "\": archive has changed");
+        }
+        // check the entry count and path sizes against the remaining bytes so a corrupted index can not trigger huge allocations
+        const auto entryCount = reader.readUInt64LE();
+        const auto remainingSize = static_cast<std::uint64_t>(reader.readRemainingBytes());
+        if (entryCount > remainingSize / minArchiveIndexEntrySize) {
+            throw ArchiveException("Unable to load archive index \"" % path + "\": entry count exceeds file size");
+        }
+        index.m_entries.resize(static_cast<std::size_t>(entryCount));
+        for (auto &entry : index.m_entries) {
+            const auto pathSize = reader.readVariableLengthUIntBE();
+            if (pathSize > remainingSize) {
+                throw ArchiveException("Unable to load archive index \"" % path + "\": path size exceeds file size");
+            }
+            entry.path = reader.readString(static_cast<std::size_t>(pathSize));
+            entry.headerOffset = reader.readUInt64LE();
+            entry.size = reader.readUInt64LE();
+            entry.modificationTime = DateTime(static_cast<DateTime::TickType>(reader.readUInt64LE()));
+            entry.permissions = static_cast<mode_t>(reader.readUInt32LE());
+            const auto type = reader.readByte();
+            if (type > static_cast<std::uint8_t>(ArchiveEntryType::Directory)) {
+                throw ArchiveException("Unable to load archive index \"" % path + "\": invalid entry type");
+            }
+            entry.type = static_cast<ArchiveEntryType>(type);
+        }
+    } catch (const std::ios_base::failure &failure) {
+        throw ArchiveException("Unable to load archive index \"" % path % "\": " + failure.what());
+    } catch (const ConversionException &e) {
+        throw ArchiveException("Unable to load archive index \"" % path % "\": " + e.what());
+    } catch (const std::length_error &e) {
+        throw ArchiveException("Unable to load archive index \"" % path % "\": " + e.what());
+    } catch (const std::bad_alloc &) {
+        throw ArchiveException("Unable to load archive index \"" % path + "\": unable to allocate memory for entries");
+    }
+    index.sortEntriesByPath();
+    return index;
+}
+
+/*!
+ * \brief Loads the index for the archive at \a archivePath from \a indexPath (defaults to defaultIndexPath()) if present
+ *        and up-to-date; otherwise builds the index and tries to save it at \a indexPath.
+ * \throws Throws ArchiveException if the index can neither be loaded nor built. Failing to save the index is ignored.
+ */
+ArchiveIndex ArchiveIndex::loadOrBuild(std::string_view archivePath, std::string_view indexPath)
+{
+    try {
+        return load(archivePath, indexPath);
+    } catch (const ArchiveException &) {
+    }
+    auto index = build(archivePath);
+    try {
+        index.save(indexPath);
+    } catch (const ArchiveException &) {
+    }
+    return index;
+}
+
+/*!
+ * \brief Saves the index at \a indexPath (defaults to defaultIndexPath()).
+ * \throws Throws ArchiveException if the index can not be written.
+ */
+void ArchiveIndex::save(std::string_view indexPath) const
+{
+    const auto path = indexPath.empty() ? defaultIndexPath(m_archivePath) : std::string(indexPath);
+    try {
+        auto file = NativeFileStream();
+        file.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+        file.open(path, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+        auto writer = BinaryWriter(&file);
+        writer.writeString("c++utilities-archive-index");
+        writer.writeByte(1);
+        writer.writeUInt64LE(m_archiveSize);
+        writer.writeInt64LE(m_archiveModificationTime);
+        writer.writeBool(m_isSeekable);
+        writer.writeUInt64LE(m_entries.size());
+        for (const auto &entry : m_entries) {
+            writer.writeLengthPrefixedString(entry.path);
+            writer.writeUInt64LE(entry.headerOffset);
+            writer.writeUInt64LE(entry.size);
+            writer.writeUInt64LE(static_cast<std::uint64_t>(entry.modificationTime.totalTicks()));
+            writer.writeUInt32LE(static_cast<std::uint32_t>(entry.permissions));
+            writer.writeByte(static_cast<std::uint8_t>(entry.type));
+        }
+        file.flush();
+    } catch (const std::ios_base::failure &failure) {
+        throw ArchiveException("Unable to save archive index \"" % path % "\": " + failure.what());
+    }
+}
+
+/*!
+ * \brief Sorts the entries by path for find(); the last entry wins if the same path occurs multiple times.
+ */
+void ArchiveIndex::sortEntriesByPath()
+{
+    m_entriesByPath.resize(m_entries.size());
+    std::iota(m_entriesByPath.begin(), m_entriesByPath.end(), std::size_t());
+    std::stable_sort(m_entriesByPath.begin(), m_entriesByPath.end(),
+        [this](std::size_t lhs, std::size_t rhs) { return m_entries[lhs].path < m_entries[rhs].path; });
+}
+
+/*!
+ * \brief Returns the entry with the specified \a path (without trailing slash) or nullptr if there is no such entry.
+ */
+const ArchiveIndexEntry *ArchiveIndex::find(std::string_view path) const
+{
+    const auto end = std::upper_bound(m_entriesByPath.begin(), m_entriesByPath.end(), path,
+        [this](std::string_view lhs, std::size_t rhs) { return lhs < m_entries[rhs].path; });
+    return end != m_entriesByPath.begin() && m_entries[*(end - 1)].path == path ? &m_entries[*(end - 1)] : nullptr;
+}
+
+/*!
+ * \brief Extracts the regular file or symlink with the specified \a path.
+ * \returns Returns the file or std::nullopt if the index contains no regular file or symlink with \a path.
+ * \throws Throws ArchiveException if the archive can not be read or the entry does not match the index anymore.
+ */
+std::optional<ArchiveFile> ArchiveIndex::extractFile(std::string_view path) const
+{
+    const auto *const indexEntry = find(path);
+    if (!indexEntry || indexEntry->type == ArchiveEntryType::Directory) {
+        return std::nullopt;
+    }
+    auto source = ArchiveFileSource();
+    auto ar = ArchiveHandle();
+    openArchiveFromFileAtOffset(ar, source, m_archivePath, m_isSeekable ? indexEntry->headerOffset : 0);
+    const auto entryGuard = ArchiveEntryGuard{ archive_entry_new() };
+    auto remainingEntries = m_isSeekable ? std::size_t() : static_cast<std::size_t>(indexEntry - m_entries.data());
+    auto type = ArchiveEntryType::Regular;
+    while (archive_read_next_header2(ar, entryGuard.entry) == ARCHIVE_OK) {
+        const auto *const entryPath = indexablePath(entryGuard.entry, type);
+        if (entryPath && !remainingEntries--) {
+            if (path != entryPath || type != indexEntry->type) {
+                break;
+            }
+            auto file = readArchiveFile(ar, entryGuard.entry, path, type);
+            ar.close(m_archivePath, std::string_view());
+            return file;
+        }
+        if (archive_read_data_skip(ar) < ARCHIVE_WARN) {
+            break;
+        }
+    }
+    const char *const error = archive_error_string(ar);
+    throw ArchiveException("Unable to extract \"" % path % "\" from archive \"" % m_archivePath % "\": "
+        + (error ? error : "the archive does not match the index"));
+}
+
+/*!
+ * \brief Returns the directory with the specified \a path (without trailing slash) or nullptr if there is no such directory.
+ * \remarks Uses binary search as directories are sorted by path.
+ */
+const CompactArchiveDirectory *CompactFileMap::findDirectory(std::string_view path) const
+{
+    const auto directory = std::lower_bound(m_directories.begin(), m_directories.end(), path,
+        [](const CompactArchiveDirectory &lhs, std::string_view rhs) { return lhs.path < rhs; });
+    return directory != m_directories.end() && directory->path == path ? &*directory : nullptr;
+}
+
+/*!
+ * \brief Extracts the specified archive into a CompactFileMap.
+ * \remarks
+ * In contrast to extractFiles(), no std::string is allocated per file name, file content and directory. Instead, file
+ * contents are streamed into one buffer which also holds all names and paths. The directory index is created by sorting
+ * the files once after extraction. This makes a big difference for archives with many small files.
+ */
+CompactFileMap extractFilesCompact(std::string_view archivePath, const FilePredicate &isFileRelevant)
+{
+    auto builder = CompactFileMapBuilder();
+    streamThroughArchive(
+        archivePath, isFileRelevant,
+        [&builder](std::string_view directoryPath, const ArchiveFile &file, const ArchiveFileChunk &chunk) {
+            return builder.addFileChunk(directoryPath, file, chunk);
+        },
+        [&builder](std::string_view directoryPath) { return builder.addDirectory(directoryPath); });
+    return builder.finalize();
+}
+
+/*!
+ * \brief Extracts the specified archive into a CompactFileMap.
+ * \remarks See extractFilesCompact() for details.
+ */
+CompactFileMap extractFilesCompactFromBuffer(std::string_view archiveData, std::string_view archiveName, const FilePredicate &isFileRelevant)
+{
+    auto builder = CompactFileMapBuilder();
+    streamThroughArchiveFromBuffer(
+        archiveData, archiveName, isFileRelevant,
+        [&builder](std::string_view directoryPath, const ArchiveFile &file, const ArchiveFileChunk &chunk) {
+            return builder.addFileChunk(directoryPath, file, chunk);
+        },
+        [&builder](std::string_view directoryPath) { return builder.addDirectory(directoryPath); });
+    return builder.finalize();
+}
+
+/*!
+ * \brief Adds the specified \a entry copying its path into the buffer of the listing.
+ * \remarks The path of the added entry is fixed up by finalize() as the buffer might be reallocated while adding entries.
+ */
+void ArchiveListing::add(const ArchiveEntry &entry)
+{
+    auto &added = m_entries.emplace_back(entry);
+    added.path = std::string_view(nullptr, entry.path.size());
+    m_pathData.insert(m_pathData.end(), entry.path.begin(), entry.path.end());
+}
+
+/*!
+ * \brief Makes the paths of all entries point into the buffer of the listing after all entries have been added.
+ */
+void ArchiveListing::finalize()
+{
+    m_pathData.shrink_to_fit();
+    m_entries.shrink_to_fit();
+    auto offset = std::size_t();
+    for (auto &entry : m_entries) {
+        entry.path = std::string_view(m_pathData.data() + offset, entry.path.size());
+        offset += entry.path.size();
+    }
+}
+
+/*!
+ * \brief Invokes \a entryHandler for the entries (directories, regular files and symlinks) in the specified archive.
+ * \remarks
+ * - In contrast to walkThroughArchive(), no file contents are read. The data of each entry is skipped via
+ *   archive_read_data_skip() which avoids decompression if the format allows it (e.g. Zip, uncompressed Tar).
+ * - If \a entryHandler returns true, the iteration is aborted.
+ */
+void walkThroughArchiveHeaders(std::string_view archivePath, ArchiveEntryHandler &&entryHandler)
+{
+    auto ar = ArchiveHandle();
+    openArchiveFromFile(ar, archivePath);
+    walkThroughArchiveHeadersInternal(ar, archivePath, std::move(entryHandler));
+}
+
+/*!
+ * \brief Invokes \a entryHandler for the entries (directories, regular files and symlinks) in the specified archive.
+ * \remarks See walkThroughArchiveHeaders() for details.
+ */
+void walkThroughArchiveHeadersFromBuffer(std::string_view archiveData, std::string_view archiveName, ArchiveEntryHandler &&entryHandler)
+{
+    auto ar = ArchiveHandle();
+    openArchiveFromBuffer(ar, archiveData, archiveName);
+    walkThroughArchiveHeadersInternal(ar, archiveName, std::move(entryHandler));
+}
+
+/*!
+ * \brief Lists the entries (directories, regular files and symlinks) in the specified archive without extracting them.
+ * \remarks See walkThroughArchiveHeaders() for details.
+ */
+ArchiveListing listArchive(std::string_view archivePath)
+{
+    auto listing = ArchiveListing();
+    walkThroughArchiveHeaders(archivePath, [&listing](const ArchiveEntry &entry) {
+        listing.add(entry);
+        return false;
+    });
+    listing.finalize();
+    return listing;
+}
+
+/*!
+ * \brief Lists the entries (directories, regular files and symlinks) in the specified archive without extracting them.
+ * \remarks See walkThroughArchiveHeaders() for details.
+ */
+ArchiveListing listArchiveFromBuffer(std::string_view archiveData, std::string_view archiveName)
+{
+    auto listing = ArchiveListing();
+    walkThroughArchiveHeadersFromBuffer(archiveData, archiveName, [&listing](const ArchiveEntry &entry) {
+        listing.add(entry);
+        return false;
+    });
+    listing.finalize();
+    return listing;
+}
+
+/*!
+ * \brief Invokes \a fileHandler for the files in the specified archives using multiple threads.
+ * \remarks
+ * - Each worker thread uses its own libarchive handle. By default, one thread per CPU core is used.
+ * - Archives are distributed over the threads by size. The files of Zip archives are additionally distributed by size over
+ *   multiple threads, each reading the archive independently and skipping files assigned to other threads. This is cheap
+ *   for Zip archives as libarchive can seek to the next file via the central directory. Other archives are processed by one
+ *   thread as skipping files would require decompressing them.
+ * - \a isFileRelevant is invoked concurrently from the worker threads so it must be thread-safe.
+ * - Without ParallelArchiveFlags::PreserveOrder, \a fileHandler is invoked concurrently from the worker threads as well.
+ *   With ParallelArchiveFlags::PreserveOrder, \a fileHandler is invoked from the calling thread in the order the files
+ *   occur in the archives and the archives occur in \a archivePaths. Archives are then processed in that order as well
+ *   and files extracted ahead of time are buffered. Once about 64 MiB are buffered, worker threads wait for \a fileHandler
+ *   to catch up. Only files of the archive currently passed to \a fileHandler are buffered regardless of that limit (so
+ *   the limit is exceeded by big files and split Zip archives).
+ * - If \a fileHandler returns true, the iteration is aborted.
+ * \throws Throws ArchiveException if an archive can not be read. If that happens, extraction is aborted.
+ */
+void walkThroughArchivesInParallel(const std::vector<std::string> &archivePaths, const FilePredicate &isFileRelevant,
+    ArchiveFileHandler &&fileHandler, ParallelArchiveFlags flags, unsigned int threadCount)
+{
+    walkThroughArchivesInParallelInternal(archivePaths, isFileRelevant, fileHandler, DirectoryHandler(), flags, threadCount);
+}
+
+/*!
+ * \brief Extracts the specified archive like extractFiles() but using multiple threads.
+ * \remarks See walkThroughArchivesInParallel() for details; \a isFileRelevant must be thread-safe.
+ */
+FileMap extractFilesInParallel(std::string_view archivePath, const FilePredicate &isFileRelevant, unsigned int threadCount)
+{
+    auto results = FileMap();
+    auto directories = std::vector<std::string>();
+    walkThroughArchivesInParallelInternal(
+        std::vector<std::string>{ std::string(archivePath) }, isFileRelevant,
+        [&results](std::string_view, std::string_view directoryPath, ArchiveFile &&file) {
+            results[std::string(directoryPath)].emplace_back(std::move(file));
+            return false;
+        },
+        [&directories](std::string_view directoryPath) {
+            directories.emplace_back(directoryPath);
+            return false;
+        },
+        ParallelArchiveFlags::PreserveOrder, threadCount);
+    for (auto &directory : directories) {
+        results[std::move(directory)];
+    }
+    return results;
+}
+
 } // namespace CppUtilities
@@ -3,9 +3,12 @@
 
 #include "../chrono/datetime.h"
 #include "../global.h"
+#include "../misc/flagenumclass.h"
 
+#include <cstdint>
 #include <functional>
 #include <map>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -74,6 +77,281 @@ struct CPP_UTILITIES_EXPORT ArchiveFile {
     ArchiveFileType type;
 };
 
+/*!
+ * \brief The ArchiveEntryType enum specifies the type of an entry listed via walkThroughArchiveHeaders() and listArchive().
+ */
+enum class ArchiveEntryType { Regular, Link, Directory };
+
+/*!
+ * \brief The ArchiveEntry struct holds the metadata of an entry within an archive without its content.
+ * \remarks
+ * - The path of directories has no trailing slashes.
+ * - The path points into the ArchiveListing the entry belongs to or, when passed to an ArchiveEntryHandler, is only valid
+ *   during the invocation of the handler.
+ */
+struct CPP_UTILITIES_EXPORT ArchiveEntry {
+    std::string_view path; /**< the full path of the entry within the archive */
+    std::uint64_t size = 0; /**< the uncompressed size (0 for directories and if unknown) */
+    CppUtilities::DateTime modificationTime; /**< the modification time (see remarks of ArchiveFile regarding the timezone) */
+    mode_t permissions = 0; /**< the permission bits */
+    ArchiveEntryType type = ArchiveEntryType::Regular; /**< the type of the entry */
+};
+
+/*!
+ * \brief The ArchiveListing class holds the metadata of all entries within an archive as returned by listArchive().
+ * \remarks The paths of all entries are stored contiguously in a single buffer owned by the listing. Hence the class is
+ *          only movable and ArchiveEntry::path is only valid as long as the listing exists.
+ */
+class CPP_UTILITIES_EXPORT ArchiveListing {
+    friend CPP_UTILITIES_EXPORT ArchiveListing listArchive(std::string_view archivePath);
+    friend CPP_UTILITIES_EXPORT ArchiveListing listArchiveFromBuffer(std::string_view archiveData, std::string_view archiveName);
+
+public:
+    explicit ArchiveListing() = default;
+    ArchiveListing(const ArchiveListing &) = delete;
+    ArchiveListing(ArchiveListing &&) = default;
+    ArchiveListing &operator=(const ArchiveListing &) = delete;
+    ArchiveListing &operator=(ArchiveListing &&) = default;
+
+    const std::vector<ArchiveEntry> &entries() const;
+
+private:
+    void add(const ArchiveEntry &entry);
+    void finalize();
+
+    std::vector<char> m_pathData;
+    std::vector<ArchiveEntry> m_entries;
+};
+
+/*!
+ * \brief Returns the entries of the archive in the order they occur within the archive.
+ */
+inline const std::vector<ArchiveEntry> &ArchiveListing::entries() const
+{
+    return m_entries;
+}
+
+/*!
+ * \brief The ArchiveFileChunk struct holds a chunk of the content of a file within an archive.
+ * \remarks The data is only valid during the invocation of the FileChunkHandler it has been passed to.
+ */
+struct CPP_UTILITIES_EXPORT ArchiveFileChunk {
+    std::string_view data; /**< the decoded data */
+    std::uint64_t offset = 0; /**< the offset of the data within the file (might skip holes of sparse files) */
+    bool isLast = false; /**< whether the end of the file has been reached (data is empty in this case) */
+};
+
+/*!
+ * \brief The ParallelArchiveFlags enum specifies how walkThroughArchivesInParallel() invokes handlers.
+ */
+enum class ParallelArchiveFlags {
+    None = 0, /**< handlers are invoked concurrently from worker threads as soon as files have been extracted */
+    PreserveOrder = (1 << 0), /**< handlers are invoked from the calling thread one after another in the order of archives and files (at
+                                   most about 64 MiB of files extracted ahead of time are buffered; see walkThroughArchivesInParallel()) */
+};
+
+class CPP_UTILITIES_EXPORT MappedArchive {
+public:
+    explicit MappedArchive(std::string_view archivePath);
+    MappedArchive(const MappedArchive &) = delete;
+    MappedArchive(MappedArchive &&other) noexcept;
+    MappedArchive &operator=(const MappedArchive &) = delete;
+    MappedArchive &operator=(MappedArchive &&) = delete;
+    ~MappedArchive();
+
+    const std::string &path() const;
+    std::string_view data() const;
+    bool contains(std::string_view data) const;
+
+private:
+    std::string m_path;
+    const char *m_data;
+    std::size_t m_size;
+#ifdef PLATFORM_WINDOWS
+    void *m_mappingHandle;
+#endif
+};
+
+/*!
+ * \brief Returns the path of the mapped archive.
+ */
+inline const std::string &MappedArchive::path() const
+{
+    return m_path;
+}
+
+/*!
+ * \brief Returns the mapped contents of the archive.
+ */
+inline std::string_view MappedArchive::data() const
+{
+    return std::string_view(m_data, m_size);
+}
+
+/*!
+ * \brief Returns whether the specified \a data points into the mapping and thus stays valid as long as the MappedArchive exists.
+ */
+inline bool MappedArchive::contains(std::string_view data) const
+{
+    return std::less_equal<const char *>()(m_data, data.data()) && std::less_equal<const char *>()(data.data() + data.size(), m_data + m_size);
+}
+
+/*!
+ * \brief The ArchiveIndexEntry struct holds the metadata and location of an entry within an archive recorded by ArchiveIndex.
+ */
+struct CPP_UTILITIES_EXPORT ArchiveIndexEntry {
+    std::string path; /**< the full path of the entry within the archive (without trailing slash for directories) */
+    std::uint64_t headerOffset = 0; /**< the offset of the entry's header within the archive file */
+    std::uint64_t size = 0; /**< the uncompressed size (0 for directories and if unknown) */
+    CppUtilities::DateTime modificationTime; /**< the modification time (see remarks of ArchiveFile regarding the timezone) */
+    mode_t permissions = 0; /**< the permission bits */
+    ArchiveEntryType type = ArchiveEntryType::Regular; /**< the type of the entry */
+};
+
+class CPP_UTILITIES_EXPORT ArchiveIndex {
+public:
+    explicit ArchiveIndex() = default;
+    static ArchiveIndex build(std::string_view archivePath);
+    static ArchiveIndex load(std::string_view archivePath, std::string_view indexPath = std::string_view());
+    static ArchiveIndex loadOrBuild(std::string_view archivePath, std::string_view indexPath = std::string_view());
+    static std::string defaultIndexPath(std::string_view archivePath);
+    void save(std::string_view indexPath = std::string_view()) const;
+
+    const std::string &archivePath() const;
+    bool isSeekable() const;
+    const std::vector<ArchiveIndexEntry> &entries() const;
+    const ArchiveIndexEntry *find(std::string_view path) const;
+    std::optional<ArchiveFile> extractFile(std::string_view path) const;
+
+private:
+    void sortEntriesByPath();
+
+    std::string m_archivePath;
+    std::vector<ArchiveIndexEntry> m_entries;
+    std::vector<std::size_t> m_entriesByPath;
+    std::uint64_t m_archiveSize = 0;
+    std::int64_t m_archiveModificationTime = 0;
+    bool m_isSeekable = false;
+};
+
+/*!
+ * \brief Returns the path of the archive the index has been created for.
+ */
+inline const std::string &ArchiveIndex::archivePath() const
+{
+    return m_archivePath;
+}
+
+/*!
+ * \brief Returns whether extractFile() can jump directly to the entry's header.
+ * \remarks This is the case for Tar, Zip and cpio archives which are not wrapped by a compression filter.
+ */
+inline bool ArchiveIndex::isSeekable() const
+{
+    return m_isSeekable;
+}
+
+/*!
+ * \brief Returns the entries (directories, regular files and symlinks) in the order they occur within the archive.
+ */
+inline const std::vector<ArchiveIndexEntry> &ArchiveIndex::entries() const
+{
+    return m_entries;
+}
+
+/*!
+ * \brief The CompactArchiveFile struct holds data about a file within an archive extracted via extractFilesCompact().
+ * \remarks The name and content point into the CompactFileMap the file belongs to.
+ */
+struct CPP_UTILITIES_EXPORT CompactArchiveFile {
+    std::string_view name;
+    std::string_view content;
+    CppUtilities::DateTime creationTime;
+    CppUtilities::DateTime modificationTime;
+    ArchiveFileType type = ArchiveFileType::Regular;
+};
+
+/*!
+ * \brief The CompactArchiveDirectory struct refers to the files within a directory of a CompactFileMap.
+ */
+struct CPP_UTILITIES_EXPORT CompactArchiveDirectory {
+    const CompactArchiveFile *begin() const;
+    const CompactArchiveFile *end() const;
+    std::size_t size() const;
+
+    std::string_view path; /**< the path of the directory (without trailing slash, empty for the top-level directory) */
+    const CompactArchiveFile *files = nullptr; /**< the first file within the directory */
+    std::size_t fileCount = 0; /**< the number of files within the directory */
+};
+
+/*!
+ * \brief Returns the first file within the directory.
+ */
+inline const CompactArchiveFile *CompactArchiveDirectory::begin() const
+{
+    return files;
+}
+
+/*!
+ * \brief Returns a pointer past the last file within the directory.
+ */
+inline const CompactArchiveFile *CompactArchiveDirectory::end() const
+{
+    return files + fileCount;
+}
+
+/*!
+ * \brief Returns the number of files within the directory.
+ */
+inline std::size_t CompactArchiveDirectory::size() const
+{
+    return fileCount;
+}
+
+/*!
+ * \brief The CompactFileMap class holds files extracted from an archive like FileMap but stores them more compactly.
+ * \remarks
+ * - All names, directory paths and contents are stored contiguously in a single buffer owned by the map. Hence the class is
+ *   only movable and the string views it hands out are only valid as long as the map exists.
+ * - Directories are sorted by path (like the keys of FileMap). Files within a directory are in the order they occur
+ *   within the archive.
+ */
+class CPP_UTILITIES_EXPORT CompactFileMap {
+    friend struct CompactFileMapBuilder;
+
+public:
+    explicit CompactFileMap() = default;
+    CompactFileMap(const CompactFileMap &) = delete;
+    CompactFileMap(CompactFileMap &&) = default;
+    CompactFileMap &operator=(const CompactFileMap &) = delete;
+    CompactFileMap &operator=(CompactFileMap &&) = default;
+
+    const std::vector<CompactArchiveDirectory> &directories() const;
+    const std::vector<CompactArchiveFile> &files() const;
+    const CompactArchiveDirectory *findDirectory(std::string_view path) const;
+
+private:
+    std::vector<char> m_data;
+    std::vector<CompactArchiveFile> m_files;
+    std::vector<CompactArchiveDirectory> m_directories;
+};
+
+/*!
+ * \brief Returns all directories sorted by path.
+ */
+inline const std::vector<CompactArchiveDirectory> &CompactFileMap::directories() const
+{
+    return m_directories;
+}
+
+/*!
+ * \brief Returns all files grouped by directory.
+ */
+inline const std::vector<CompactArchiveFile> &CompactFileMap::files() const
+{
+    return m_files;
+}
+
 /// \brief A map of files extracted from an archive. Keys represent directories and values files within those directories.
 using FileMap = std::map<std::string, std::vector<ArchiveFile>>;
 /// \brief A function that is invoked for each file within an archive. If it returns true, the file is considered; otherwise the file is ignored.
@@ -82,6 +360,12 @@ using FilePredicate = std::function<bool(const char *, const char *, mode_t)>;
 using DirectoryHandler = std::function<bool(std::string_view path)>;
 /// \brief A function that is invoked by the walk-through-functions to return a file.
 using FileHandler = std::function<bool(std::string_view path, ArchiveFile &&file)>;
+/// \brief A function that is invoked by walkThroughArchivesInParallel() to return a file of the archive at the specified path.
+using ArchiveFileHandler = std::function<bool(std::string_view archivePath, std::string_view path, ArchiveFile &&file)>;
+/// \brief A function that is invoked by walkThroughArchiveHeaders() for each entry within an archive.
+using ArchiveEntryHandler = std::function<bool(const ArchiveEntry &entry)>;
+/// \brief A function that is invoked by the stream-through-functions for each chunk of a file's content as it is decoded.
+using FileChunkHandler = std::function<bool(std::string_view path, const ArchiveFile &file, const ArchiveFileChunk &chunk)>;
 
 CPP_UTILITIES_EXPORT FileMap extractFiles(std::string_view archivePath, const FilePredicate &isFileRelevant = FilePredicate());
 CPP_UTILITIES_EXPORT void walkThroughArchive(std::string_view archivePath, const FilePredicate &isFileRelevant = FilePredicate(),
@@ -91,7 +375,31 @@ CPP_UTILITIES_EXPORT FileMap extractFilesFromBuffer(
 CPP_UTILITIES_EXPORT void walkThroughArchiveFromBuffer(std::string_view archiveData, std::string_view archiveName,
     const FilePredicate &isFileRelevant = FilePredicate(), FileHandler &&fileHandler = FileHandler(),
     DirectoryHandler &&directoryHandler = DirectoryHandler());
+CPP_UTILITIES_EXPORT void streamThroughArchive(std::string_view archivePath, const FilePredicate &isFileRelevant = FilePredicate(),
+    FileChunkHandler &&fileChunkHandler = FileChunkHandler(), DirectoryHandler &&directoryHandler = DirectoryHandler());
+CPP_UTILITIES_EXPORT void streamThroughArchiveFromBuffer(std::string_view archiveData, std::string_view archiveName,
+    const FilePredicate &isFileRelevant = FilePredicate(), FileChunkHandler &&fileChunkHandler = FileChunkHandler(),
+    DirectoryHandler &&directoryHandler = DirectoryHandler());
+CPP_UTILITIES_EXPORT void walkThroughArchive(const MappedArchive &archive, const FilePredicate &isFileRelevant = FilePredicate(),
+    FileHandler &&fileHandler = FileHandler(), DirectoryHandler &&directoryHandler = DirectoryHandler());
+CPP_UTILITIES_EXPORT void streamThroughArchive(const MappedArchive &archive, const FilePredicate &isFileRelevant = FilePredicate(),
+    FileChunkHandler &&fileChunkHandler = FileChunkHandler(), DirectoryHandler &&directoryHandler = DirectoryHandler());
+CPP_UTILITIES_EXPORT CompactFileMap extractFilesCompact(std::string_view archivePath, const FilePredicate &isFileRelevant = FilePredicate());
+CPP_UTILITIES_EXPORT CompactFileMap extractFilesCompactFromBuffer(
+    std::string_view archiveData, std::string_view archiveName, const FilePredicate &isFileRelevant = FilePredicate());
+CPP_UTILITIES_EXPORT void walkThroughArchiveHeaders(std::string_view archivePath, ArchiveEntryHandler &&entryHandler);
+CPP_UTILITIES_EXPORT void walkThroughArchiveHeadersFromBuffer(
+    std::string_view archiveData, std::string_view archiveName, ArchiveEntryHandler &&entryHandler);
+CPP_UTILITIES_EXPORT ArchiveListing listArchive(std::string_view archivePath);
+CPP_UTILITIES_EXPORT ArchiveListing listArchiveFromBuffer(std::string_view archiveData, std::string_view archiveName);
+CPP_UTILITIES_EXPORT void walkThroughArchivesInParallel(const std::vector<std::string> &archivePaths,
+    const FilePredicate &isFileRelevant = FilePredicate(), ArchiveFileHandler &&fileHandler = ArchiveFileHandler(),
+    ParallelArchiveFlags flags = ParallelArchiveFlags::None, unsigned int threadCount = 0);
+CPP_UTILITIES_EXPORT FileMap extractFilesInParallel(
+    std::string_view archivePath, const FilePredicate &isFileRelevant = FilePredicate(), unsigned int threadCount = 0);
 
 } // namespace CppUtilities
 
+CPP_UTILITIES_MARK_FLAG_ENUM_CLASS(CppUtilities, CppUtilities::ParallelArchiveFlags);
+
 #endif // CPP_UTILITIES_ARCHIVE_H
@@ -1,5 +1,11 @@
 #include "./buffersearch.h"
 
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <stdexcept>
+
 using namespace std;
 
 namespace CppUtilities {
@@ -22,52 +28,96 @@ namespace CppUtilities {
  *
  */
 
+/// \cond
+/// \brief Returns the first occurrence of \a c within [\a begin, \a end) or \a end if \a c does not occur.
+static const char *findChar(const char *begin, const char *end, char c)
+{
+    const auto *const occurrence = static_cast<const char *>(std::memchr(begin, c, static_cast<std::size_t>(end - begin)));
+    return occurrence ? occurrence : end;
+}
+
+/// \brief Advances \a termIterator if \a currentChar matches; otherwise falls back to the longest prefix of \a term which is still matched.
+/// \remarks The matched data is known to be the matched prefix of \a term followed by \a currentChar so the fallback is determined by
+///          comparing \a term against itself. This way self-overlapping terms like "aab" are found in "aaab" as well without requiring
+///          a precomputed failure table.
+static void advanceTermIterator(std::string_view term, std::string_view::const_iterator &termIterator, char currentChar)
+{
+    if (currentChar == *termIterator) {
+        ++termIterator;
+        return;
+    }
+    const auto matched = static_cast<std::size_t>(termIterator - term.begin());
+    auto fallback = matched;
+    for (; fallback; --fallback) {
+        if (term[fallback - 1] == currentChar && term.compare(0, fallback - 1, term, matched - fallback + 1, fallback - 1) == 0) {
+            break;
+        }
+    }
+    termIterator = term.begin() + static_cast<std::ptrdiff_t>(fallback);
+}
+/// \endcond
+
 /*!
  * \brief Processes the specified \a buffer. Invokes the callback according to the remarks mentioned in the class documentation.
  * \returns
  * - Returns the offset in \a buffer after the search term and search result. This is the first character after the search term if
  *   no termination characters have been specified; otherwiese it is the offset of the termination character.
  * - Returns nullptr if the search term could not be found.
+ * \remarks
+ * As long as no partial match of the search term or give-up term is pending, the buffer is skipped via std::memchr() to the next
+ * occurrence of the first character of either term. The search result is located and copied in bulk as well. So large buffers
+ * which rarely contain the search term are processed at the speed of std::memchr() rather than character by character.
  */
 const std::string_view::value_type *BufferSearch::process(const std::string_view::value_type *buffer, std::size_t bufferSize)
 {
     if (m_hasResult || (!m_giveUpTerm.empty() && m_giveUpTermIterator == m_giveUpTerm.end())) {
         return nullptr;
     }
-    for (auto i = buffer, end = buffer + bufferSize; i != end; ++i) {
-        const auto currentChar = *i;
+    const auto *const end = buffer + bufferSize;
+    const char *nextSearchTermStart = nullptr, *nextGiveUpTermStart = nullptr;
+    for (auto i = buffer; i != end; ++i) {
         if (m_searchTermIterator == m_searchTerm.end()) {
             if (m_terminationChars.empty()) {
                 m_hasResult = true;
             } else {
-                for (const auto &terminationChar : m_terminationChars) {
-                    if (currentChar == terminationChar) {
-                        m_hasResult = true;
-                        break;
-                    }
+                const auto terminationChar = m_terminationChars.size() == 1
+                    ? findChar(i, end, m_terminationChars.front())
+                    : std::find_first_of(i, end, m_terminationChars.begin(), m_terminationChars.end());
+                m_result.append(i, static_cast<std::size_t>(terminationChar - i));
+                if (terminationChar == end) {
+                    return nullptr;
                 }
+                i = terminationChar;
+                m_hasResult = true;
             }
-            if (m_hasResult) {
-                if (m_callback) {
-                    m_callback(*this, std::move(m_result));
-                }
-                return i;
+            if (m_callback) {
+                m_callback(*this, std::move(m_result));
             }
-            m_result += currentChar;
-            continue;
+            return i;
         }
-        if (currentChar == *m_searchTermIterator) {
-            ++m_searchTermIterator;
-        } else {
-            m_searchTermIterator = m_searchTerm.begin();
+
+        // skip to the next character which might start the search term or the give-up term if there is no partial match
+        if (m_searchTermIterator == m_searchTerm.begin() && (m_giveUpTerm.empty() || m_giveUpTermIterator == m_giveUpTerm.begin())) {
+            if (!nextSearchTermStart || nextSearchTermStart < i) {
+                nextSearchTermStart = findChar(i, end, m_searchTerm.front());
+            }
+            if (!m_giveUpTerm.empty() && (!nextGiveUpTermStart || nextGiveUpTermStart < i)) {
+                nextGiveUpTermStart = findChar(i, end, m_giveUpTerm.front());
+            }
+            i = m_giveUpTerm.empty() ? nextSearchTermStart : std::min(nextSearchTermStart, nextGiveUpTermStart);
+            if (i == end) {
+                break;
+            }
         }
-        if (m_giveUpTerm.empty()) {
+
+        const auto currentChar = *i;
+        advanceTermIterator(m_searchTerm, m_searchTermIterator, currentChar);
+        if (m_giveUpTerm.empty() || m_searchTermIterator == m_searchTerm.end()) {
             continue;
         }
-        if (currentChar == *m_giveUpTermIterator) {
-            ++m_giveUpTermIterator;
-        } else {
-            m_giveUpTermIterator = m_giveUpTerm.begin();
+        advanceTermIterator(m_giveUpTerm, m_giveUpTermIterator, currentChar);
+        if (m_giveUpTermIterator == m_giveUpTerm.end()) {
+            return nullptr;
         }
     }
     return nullptr;
@@ -94,4 +144,187 @@ void BufferSearch::reset()
     m_result.clear();
 }
 
+/*!
+ * \class MultiBufferSearch
+ * \brief The MultiBufferSearch class invokes a callback if one of many initially given search terms occurs in consecutively
+ *        provided buffers.
+ *
+ * This class behaves like BufferSearch (see remarks there) but looks for multiple search terms at once. Hence it is more
+ * efficient than running one BufferSearch per search term over the same data. The index of the search term which has been
+ * found is passed to the callback and can be queried via matchedTerm().
+ *
+ * \remarks
+ * - The search terms are compiled into an Aho-Corasick automaton within the constructor. Processing a buffer is therefore a
+ *   single table lookup per character, regardless of the number and length of the search terms.
+ * - If multiple search terms end at the same position, the longest one is reported. If a search term and the give-up term end
+ *   at the same position, the search term takes precedence. Empty search terms are ignored.
+ * - If no termination characters are specified, the callback is invoked directly after the last character of the search term
+ *   (and not only when the next character is processed as done by BufferSearch).
+ */
+
+/*!
+ * \brief Constructs a new MultiBufferSearch for the specified \a searchTerms.
+ * \remarks The specified terms are only needed during construction and may be destroyed afterwards.
+ * \throws Throws std::length_error if the search terms are too long to be represented by the automaton.
+ */
+MultiBufferSearch::MultiBufferSearch(const std::string_view *searchTerms, std::size_t searchTermCount, std::string_view terminationChars,
+    std::string_view giveUpTerm, CallbackType &&callback)
+    : m_searchTermCount(searchTermCount)
+    , m_classCount(1)
+    , m_charClasses()
+    , m_terminationChars()
+    , m_hasTerminationChars(!terminationChars.empty())
+    , m_callback(std::move(callback))
+    , m_state(0)
+    , m_matchedTerm(noTerm)
+    , m_hasResult(false)
+    , m_hasGivenUp(false)
+{
+    for (const auto terminationChar : terminationChars) {
+        m_terminationChars[static_cast<unsigned char>(terminationChar)] = true;
+    }
+
+    // assign a class to each character occurring in any term; all other characters share class 0 so the table stays small
+    const auto forEachTerm = [&](auto &&termCallback) {
+        for (auto i = std::size_t(); i != searchTermCount; ++i) {
+            termCallback(searchTerms[i], i);
+        }
+        termCallback(giveUpTerm, searchTermCount);
+    };
+    auto maxStateCount = std::size_t(1);
+    forEachTerm([&](std::string_view term, std::size_t) {
+        maxStateCount += term.size();
+        for (const auto c : term) {
+            if (auto &charClass = m_charClasses[static_cast<unsigned char>(c)]; !charClass) {
+                charClass = static_cast<std::uint16_t>(m_classCount++);
+            }
+        }
+    });
+    if (maxStateCount > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::length_error("search terms exceed max length");
+    }
+
+    // build trie (transitions to state 0 denote missing edges at this point as no edge leads back to the root yet)
+    m_transitions.resize(m_classCount);
+    m_matches.resize(1, noTerm);
+    forEachTerm([&](std::string_view term, std::size_t termIndex) {
+        if (term.empty()) {
+            return;
+        }
+        auto state = std::uint32_t();
+        for (const auto c : term) {
+            const auto index = state * m_classCount + m_charClasses[static_cast<unsigned char>(c)];
+            if (!m_transitions[index]) {
+                m_transitions[index] = static_cast<std::uint32_t>(m_matches.size());
+                m_matches.emplace_back(noTerm);
+                m_transitions.resize(m_transitions.size() + m_classCount);
+            }
+            state = m_transitions[index];
+        }
+        if (m_matches[state] == noTerm) {
+            m_matches[state] = termIndex;
+        }
+    });
+
+    // compute failure links in BFS order and turn the trie into a complete DFA
+    const auto isSearchTerm = [this](std::size_t termIndex) { return termIndex < m_searchTermCount; };
+    auto failureLinks = std::vector<std::uint32_t>(m_matches.size());
+    auto queue = std::deque<std::uint32_t>();
+    for (auto charClass = std::size_t(); charClass != m_classCount; ++charClass) {
+        if (const auto next = m_transitions[charClass]) {
+            queue.emplace_back(next);
+        }
+    }
+    for (; !queue.empty(); queue.pop_front()) {
+        const auto state = queue.front();
+        const auto failureState = failureLinks[state];
+        for (auto charClass = std::size_t(); charClass != m_classCount; ++charClass) {
+            auto &next = m_transitions[state * m_classCount + charClass];
+            const auto failureNext = m_transitions[failureState * m_classCount + charClass];
+            if (!next) {
+                next = failureNext;
+                continue;
+            }
+            failureLinks[next] = failureNext;
+            queue.emplace_back(next);
+        }
+        // inherit the match of the longest proper suffix, preferring search terms over the give-up term
+        if (const auto inherited = m_matches[failureState]; inherited != noTerm) {
+            auto &own = m_matches[state];
+            if (own == noTerm || (!isSearchTerm(own) && isSearchTerm(inherited))) {
+                own = inherited;
+            }
+        }
+    }
+}
+
+/*!
+ * \brief Processes the specified \a buffer. Invokes the callback according to the remarks mentioned in the class documentation.
+ * \returns
+ * - Returns the offset in \a buffer after the search term and search result. This is the first character after the search term if
+ *   no termination characters have been specified; otherwise it is the offset of the termination character.
+ * - Returns nullptr if no search term could be found.
+ */
+const std::string_view::value_type *MultiBufferSearch::process(const std::string_view::value_type *buffer, std::size_t bufferSize)
+{
+    if (m_hasResult || m_hasGivenUp) {
+        return nullptr;
+    }
+    auto i = buffer;
+    const auto end = buffer + bufferSize;
+    if (m_matchedTerm == noTerm) {
+        const auto *const transitions = m_transitions.data();
+        const auto *const matches = m_matches.data();
+        auto state = m_state;
+        for (; i != end; ++i) {
+            state = transitions[state * m_classCount + m_charClasses[static_cast<unsigned char>(*i)]];
+            if (const auto match = matches[state]; match != noTerm) {
+                if (match == m_searchTermCount) {
+                    m_state = state;
+                    m_hasGivenUp = true;
+                    return nullptr;
+                }
+                m_matchedTerm = match;
+                ++i;
+                break;
+            }
+        }
+        m_state = state;
+        if (m_matchedTerm == noTerm) {
+            return nullptr;
+        }
+        if (!m_hasTerminationChars) {
+            m_hasResult = true;
+            if (m_callback) {
+                m_callback(*this, m_matchedTerm, std::move(m_result));
+            }
+            return i;
+        }
+    }
+    const auto resultBegin = i;
+    for (; i != end && !m_terminationChars[static_cast<unsigned char>(*i)]; ++i)
+        ;
+    m_result.append(resultBegin, static_cast<std::size_t>(i - resultBegin));
+    if (i == end) {
+        return nullptr;
+    }
+    m_hasResult = true;
+    if (m_callback) {
+        m_callback(*this, m_matchedTerm, std::move(m_result));
+    }
+    return i;
+}
+
+/*!
+ * \brief Resets the search to its initial state (assuming no characters of any search term or the give-up term have been found yet).
+ */
+void MultiBufferSearch::reset()
+{
+    m_state = 0;
+    m_matchedTerm = noTerm;
+    m_hasResult = false;
+    m_hasGivenUp = false;
+    m_result.clear();
+}
+
 } // namespace CppUtilities
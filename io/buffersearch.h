@@ -4,10 +4,13 @@
 #include "../global.h"
 
 #include <array>
+#include <cstdint>
 #include <functional>
+#include <initializer_list>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace CppUtilities {
 
@@ -96,6 +99,119 @@ inline const std::string &BufferSearch::result() const
     return m_result;
 }
 
+class CPP_UTILITIES_EXPORT MultiBufferSearch {
+public:
+    using CallbackType = std::function<void(MultiBufferSearch &, std::size_t, std::string &&)>;
+    static constexpr auto noTerm = static_cast<std::size_t>(-1);
+
+    MultiBufferSearch(std::initializer_list<std::string_view> searchTerms, std::string_view terminationChars, std::string_view giveUpTerm,
+        CallbackType &&callback);
+    MultiBufferSearch(const std::string_view *searchTerms, std::size_t searchTermCount, std::string_view terminationChars,
+        std::string_view giveUpTerm, CallbackType &&callback);
+    void operator()(std::string_view buffer);
+    void operator()(const std::string_view::value_type *buffer, std::size_t bufferSize);
+    template <std::size_t bufferCapacity>
+    void operator()(std::shared_ptr<std::array<std::string_view::value_type, bufferCapacity>> buffer, std::size_t bufferSize);
+    const std::string_view::value_type *process(std::string_view buffer);
+    const std::string_view::value_type *process(const std::string_view::value_type *buffer, std::size_t bufferSize);
+    void reset();
+    std::size_t matchedTerm() const;
+    bool hasGivenUp() const;
+    std::string &result();
+    const std::string &result() const;
+
+private:
+    std::size_t m_searchTermCount;
+    std::size_t m_classCount;
+    std::array<std::uint16_t, 256> m_charClasses;
+    std::array<bool, 256> m_terminationChars;
+    bool m_hasTerminationChars;
+    std::vector<std::uint32_t> m_transitions;
+    std::vector<std::size_t> m_matches;
+    const CallbackType m_callback;
+    std::uint32_t m_state;
+    std::size_t m_matchedTerm;
+    std::string m_result;
+    bool m_hasResult;
+    bool m_hasGivenUp;
+};
+
+/*!
+ * \brief Constructs a new MultiBufferSearch for the specified \a searchTerms.
+ * \remarks The specified terms are only needed during construction and may be destroyed afterwards.
+ */
+inline MultiBufferSearch::MultiBufferSearch(
+    std::initializer_list<std::string_view> searchTerms, std::string_view terminationChars, std::string_view giveUpTerm, CallbackType &&callback)
+    : MultiBufferSearch(searchTerms.begin(), searchTerms.size(), terminationChars, giveUpTerm, std::move(callback))
+{
+}
+
+/*!
+ * \brief Processes the specified \a buffer. Invokes the callback according to the remarks mentioned in the class documentation.
+ */
+inline void MultiBufferSearch::operator()(std::string_view buffer)
+{
+    process(buffer.data(), buffer.size());
+}
+
+/*!
+ * \brief Processes the specified \a buffer. Invokes the callback according to the remarks mentioned in the class documentation.
+ */
+inline void MultiBufferSearch::operator()(const std::string_view::value_type *buffer, std::size_t bufferSize)
+{
+    process(buffer, bufferSize);
+}
+
+/*!
+ * \brief Processes the specified \a buffer which is a shared array with fixed \tparam bufferCapacity. Invokes the callback according to the remarks mentioned in the class documentation.
+ */
+template <std::size_t bufferCapacity>
+inline void MultiBufferSearch::operator()(std::shared_ptr<std::array<std::string_view::value_type, bufferCapacity>> buffer, std::size_t bufferSize)
+{
+    process(buffer->data(), bufferSize);
+}
+
+/*!
+ * \brief Processes the specified \a buffer. Invokes the callback according to the remarks mentioned in the class documentation.
+ * \returns See other overload for details.
+ */
+inline const std::string_view::value_type *MultiBufferSearch::process(std::string_view buffer)
+{
+    return process(buffer.data(), buffer.size());
+}
+
+/*!
+ * \brief Returns the index of the search term which has been found or MultiBufferSearch::noTerm if none has been found yet.
+ */
+inline std::size_t MultiBufferSearch::matchedTerm() const
+{
+    return m_matchedTerm;
+}
+
+/*!
+ * \brief Returns whether the give-up term has occurred.
+ */
+inline bool MultiBufferSearch::hasGivenUp() const
+{
+    return m_hasGivenUp;
+}
+
+/*!
+ * \brief Returns the search result at this point.
+ */
+inline std::string &MultiBufferSearch::result()
+{
+    return m_result;
+}
+
+/*!
+ * \brief Returns the search result at this point.
+ */
+inline const std::string &MultiBufferSearch::result() const
+{
+    return m_result;
+}
+
 } // namespace CppUtilities
 
 #endif // IOUTILITIES_BUFFER_SEARCH_H
@@ -1,28 +1,278 @@
+#define CPP_UTILITIES_PATHHELPER_STRING_VIEW
+
 #include "./inifile.h"
+#include "./misc.h"
+#include "./path.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <system_error>
+#include <thread>
+#include <utility>
+#ifdef CPP_UTILITIES_USE_STANDARD_FILESYSTEM
+#include <filesystem>
+#endif
 
 using namespace std;
 
 namespace CppUtilities {
 
 /// \cond
-static void addChar(char c, std::string &to, std::size_t &padding)
+/*!
+ * \brief Returns the first occurrence of \a c within [\a begin, \a end) or \a end if there is none.
+ */
+static const char *findChar(const char *begin, const char *end, char c)
+{
+    if (begin == end) {
+        return end;
+    }
+    const auto i = static_cast<const char *>(std::memchr(begin, c, static_cast<std::size_t>(end - begin)));
+    return i ? i : end;
+}
+
+/*!
+ * \brief Returns the first occurrence of one of the specified \a chars within [\a begin, \a end) or \a end if there is none.
+ */
+template <typename... Chars> static const char *findFirstOf(const char *begin, const char *end, Chars... chars)
 {
-    if (c == ' ') {
-        ++padding;
+    for (; begin != end && ((*begin != chars) && ...); ++begin)
+        ;
+    return begin;
+}
+
+/*!
+ * \brief Returns [\a begin, \a end) without leading and trailing spaces.
+ */
+static std::string_view trimSpaces(const char *begin, const char *end)
+{
+    for (; begin != end && *begin == ' '; ++begin)
+        ;
+    for (; end != begin && *(end - 1) == ' '; --end)
+        ;
+    return std::string_view(begin, static_cast<std::size_t>(end - begin));
+}
+
+/*!
+ * \brief Appends \a chars to \a to postponing spaces so leading and trailing spaces are omitted.
+ * \remarks The number of postponed spaces is tracked via \a padding. They are inserted before the next non-space
+ *          character if \a to is not empty at this point.
+ */
+static void addChars(std::string_view chars, std::string &to, std::size_t &padding)
+{
+    const auto firstNonSpace = chars.find_first_not_of(' ');
+    if (firstNonSpace == std::string_view::npos) {
+        padding += chars.size();
         return;
     }
+    const auto lastNonSpace = chars.find_last_not_of(' ');
     if (!to.empty()) {
-        while (padding) {
-            to += ' ';
-            --padding;
+        to.append(padding + firstNonSpace, ' ');
+    }
+    to.append(chars.data() + firstNonSpace, lastNonSpace + 1 - firstNonSpace);
+    padding = chars.size() - lastNonSpace - 1;
+}
+
+/*!
+ * \brief Reads all remaining data from the specified \a inputStream.
+ * \throws Throws an std::ios_base::failure when an IO error (other than end-of-file) occurs.
+ */
+static std::string readRemainingData(std::istream &inputStream)
+{
+    constexpr auto chunkSize = std::size_t(16 * 1024);
+    auto data = std::string();
+    try {
+        for (;;) {
+            const auto offset = data.size();
+            data.resize(offset + chunkSize);
+            inputStream.read(data.data() + offset, static_cast<std::streamsize>(chunkSize));
+        }
+    } catch (const std::ios_base::failure &) {
+        if (!inputStream.eof()) {
+            throw;
         }
-    } else {
-        padding = 0;
+        data.resize(data.size() - chunkSize + static_cast<std::size_t>(inputStream.gcount()));
     }
-    to += c;
-};
+    return data;
+}
+
+/*!
+ * \brief Parses the specified \a buffer calling \a handleField for each "key = value"-pair.
+ * \remarks The scope name, key and value are passed as views into \a buffer.
+ */
+template <typename FieldHandler> static void parseIniFile(std::string_view buffer, FieldHandler &&handleField)
+{
+    auto sectionName = std::string_view();
+    for (auto i = buffer.data(), end = buffer.data() + buffer.size(); i != end;) {
+        switch (*i) {
+        case '\n':
+            ++i;
+            continue;
+        case '#':
+            i = findChar(i, end, '\n');
+            continue;
+        case '[': {
+            const auto sectionNameEnd = findChar(i + 1, end, ']');
+            if (sectionNameEnd == end) {
+                return;
+            }
+            sectionName = std::string_view(i + 1, static_cast<std::size_t>(sectionNameEnd - i - 1));
+            i = sectionNameEnd + 1;
+            continue;
+        }
+        default:;
+        }
+
+        // read key (and value if there's an equal sign)
+        const auto keyEnd = findFirstOf(i, end, '=', '#', '\n');
+        const auto key = trimSpaces(i, keyEnd);
+        if (keyEnd == end || *keyEnd != '=') {
+            if (!key.empty()) {
+                handleField(sectionName, key, std::string_view());
+            }
+            i = keyEnd;
+            continue;
+        }
+        const auto valueEnd = findFirstOf(keyEnd + 1, end, '#', '\n');
+        handleField(sectionName, key, trimSpaces(keyEnd + 1, valueEnd));
+        i = valueEnd;
+    }
+}
+
+/*!
+ * \brief Returns whether the data of the specified sections (except the fields) is equal.
+ */
+static bool isSameElement(const AdvancedIniFile::Section &lhs, const AdvancedIniFile::Section &rhs)
+{
+    return lhs.name == rhs.name && lhs.precedingCommentBlock == rhs.precedingCommentBlock
+        && lhs.followingInlineComment == rhs.followingInlineComment && lhs.flags == rhs.flags;
+}
+
+/*!
+ * \brief Returns whether the data of the specified fields is equal.
+ */
+static bool isSameElement(const AdvancedIniFile::Field &lhs, const AdvancedIniFile::Field &rhs)
+{
+    return lhs.key == rhs.key && lhs.value == rhs.value && lhs.precedingCommentBlock == rhs.precedingCommentBlock
+        && lhs.followingInlineComment == rhs.followingInlineComment && lhs.paddedKeyLength == rhs.paddedKeyLength && lhs.flags == rhs.flags;
+}
+
+/*!
+ * \brief Appends the specified \a section (without fields) to \a out like AdvancedIniFile::make() writes it.
+ */
+static void appendElement(std::string &out, const AdvancedIniFile::Section &section)
+{
+    out += section.precedingCommentBlock;
+    if (section.flags && IniFileSectionFlags::Implicit) {
+        return;
+    }
+    out += '[';
+    out += section.name;
+    out += ']';
+    if (!section.followingInlineComment.empty()) {
+        out += ' ';
+        out += section.followingInlineComment;
+    }
+    out += '\n';
+}
+
+/*!
+ * \brief Appends the specified \a field to \a out like AdvancedIniFile::make() writes it.
+ */
+static void appendElement(std::string &out, const AdvancedIniFile::Field &field)
+{
+    out += field.precedingCommentBlock;
+    out += field.key;
+    if (field.key.size() < field.paddedKeyLength) {
+        out.append(field.paddedKeyLength - field.key.size(), ' ');
+    }
+    if (field.flags && IniFileFieldFlags::HasValue) {
+        out += '=';
+        out += ' ';
+        out += field.value;
+    }
+    if (!field.followingInlineComment.empty()) {
+        if (field.flags && IniFileFieldFlags::HasValue) {
+            out += ' ';
+        }
+        out += field.followingInlineComment;
+    }
+    out += '\n';
+}
+
+/*!
+ * \brief Returns whether \a element has been parsed with IniFileParseOptions::TrackSource and has not been modified since then.
+ * \remarks \a originalElements must contain the elements parsed from the source again (ordered by their offset).
+ */
+template <typename Element> static bool isUnmodified(const Element &element, const std::vector<const Element *> &originalElements)
+{
+    if (!element.source.isPresent) {
+        return false;
+    }
+    const auto offset = element.source.offset;
+    auto i = std::lower_bound(originalElements.begin(), originalElements.end(), offset,
+        [](const Element *originalElement, std::size_t value) { return originalElement->source.offset < value; });
+    for (; i != originalElements.end() && (*i)->source.offset == offset; ++i) {
+        if ((*i)->source.size == element.source.size && isSameElement(**i, element)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*!
+ * \brief Calls \a handlePiece for each element of \a file in the order they are written.
+ * \remarks
+ * - Passes the source range and the original data for unmodified elements and nullptr and the re-generated
+ *   data for modified (or new) elements.
+ * - Modifications are detected by comparing each element with the element parsed from its source range. Therefore
+ *   \a source is parsed again.
+ * - A line break is prepended to re-generated data if the previous piece does not end with one (which is the case if
+ *   the last element of \a source is not terminated by a line break).
+ */
+template <typename PieceHandler> static void forEachPiece(const AdvancedIniFile &file, std::string_view source, PieceHandler &&handlePiece)
+{
+    auto original = AdvancedIniFile();
+    original.parse(source, IniFileParseOptions::TrackSource);
+    auto originalSections = std::vector<const AdvancedIniFile::Section *>();
+    auto originalFields = std::vector<const AdvancedIniFile::Field *>();
+    originalSections.reserve(original.sections.size());
+    for (const auto &section : original.sections) {
+        originalSections.emplace_back(&section);
+        for (const auto &field : section.fields) {
+            originalFields.emplace_back(&field);
+        }
+    }
+
+    auto buffer = std::string();
+    auto needsLineBreak = false;
+    const auto handleElement = [&](const auto &element, const auto &originalElements) {
+        if (isUnmodified(element, originalElements)) {
+            const auto piece = source.substr(element.source.offset, element.source.size);
+            if (!piece.empty()) {
+                needsLineBreak = piece.back() != '\n';
+            }
+            handlePiece(&element.source, piece);
+            return;
+        }
+        buffer.clear();
+        appendElement(buffer, element);
+        if (!buffer.empty() && std::exchange(needsLineBreak, buffer.back() != '\n')) {
+            buffer.insert(buffer.begin(), '\n');
+        }
+        handlePiece(static_cast<const AdvancedIniFile::SourceRange *>(nullptr), std::string_view(buffer));
+    };
+    for (const auto &section : file.sections) {
+        handleElement(section, originalSections);
+        for (const auto &field : section.fields) {
+            handleElement(field, originalFields);
+        }
+    }
+}
 /// \endcond
 
 /*!
@@ -33,121 +283,49 @@ static void addChar(char c, std::string &to, std::size_t &padding)
 
 /*!
  * \brief Parses all data from the specified \a inputStream.
+ * \remarks Reads all data into a buffer first and then parses it via parse(std::string_view).
  * \throws Throws an std::ios_base::failure when an IO error (other than end-of-file) occurs.
  */
 void IniFile::parse(std::istream &inputStream)
 {
     inputStream.exceptions(ios_base::failbit | ios_base::badbit);
+    parse(readRemainingData(inputStream));
+}
 
-    // define variables for state machine
-    enum State { Init, Comment, SectionName, Key, Value } state = Init;
-    char currentCharacter;
-
-    // keep track of current scope, key and value and number of postponed whitespaces
-    std::size_t whitespace = 0;
-    string sectionName, key, value;
-    sectionName.reserve(16);
-    key.reserve(16);
-    value.reserve(256);
-
-    // define function to add a key/value pair
-    const auto finishKeyValue = [&state, &sectionName, &key, &value, &whitespace, this] {
-        if (key.empty() && value.empty() && state != Value) {
-            return;
-        }
+/*!
+ * \brief Parses all data from the specified \a buffer.
+ * \remarks The buffer is scanned for delimiters line by line (instead of char by char) and the parsed strings are
+ *          assigned as a whole.
+ */
+void IniFile::parse(std::string_view buffer)
+{
+    parseIniFile(buffer, [this](std::string_view sectionName, std::string_view key, std::string_view value) {
         if (m_data.empty() || m_data.back().first != sectionName) {
-            m_data.emplace_back(make_pair(sectionName, decltype(m_data)::value_type::second_type()));
+            m_data.emplace_back(ScopeName(sectionName), ScopeData());
         }
-        m_data.back().second.insert(make_pair(key, value));
-        key.clear();
-        value.clear();
-        whitespace = 0;
-    };
+        m_data.back().second.emplace(key, value);
+    });
+}
 
-    // parse the file char by char
-    try {
-        while (inputStream.get(currentCharacter)) {
-            // handle next character
-            switch (state) {
-            case Init:
-                switch (currentCharacter) {
-                case '\n':
-                    break;
-                case '#':
-                    state = Comment;
-                    break;
-                case '=':
-                    whitespace = 0;
-                    state = Value;
-                    break;
-                case '[':
-                    sectionName.clear();
-                    state = SectionName;
-                    break;
-                default:
-                    addChar(currentCharacter, key, whitespace);
-                    state = Key;
-                }
-                break;
-            case Key:
-                switch (currentCharacter) {
-                case '\n':
-                    finishKeyValue();
-                    state = Init;
-                    break;
-                case '#':
-                    finishKeyValue();
-                    state = Comment;
-                    break;
-                case '=':
-                    whitespace = 0;
-                    state = Value;
-                    break;
-                default:
-                    addChar(currentCharacter, key, whitespace);
-                }
-                break;
-            case Comment:
-                switch (currentCharacter) {
-                case '\n':
-                    state = Init;
-                    break;
-                default:;
-                }
-                break;
-            case SectionName:
-                switch (currentCharacter) {
-                case ']':
-                    state = Init;
-                    break;
-                default:
-                    sectionName += currentCharacter;
-                }
-                break;
-            case Value:
-                switch (currentCharacter) {
-                case '\n':
-                    finishKeyValue();
-                    state = Init;
-                    break;
-                case '#':
-                    finishKeyValue();
-                    state = Comment;
-                    break;
-                default:
-                    addChar(currentCharacter, value, whitespace);
-                }
-                break;
-            }
-        }
-    } catch (const std::ios_base::failure &) {
-        if (!inputStream.eof()) {
-            throw;
+/*!
+ * \brief Parses the specified \a buffer without copying any of the data.
+ * \returns Returns the [scope names] and the contained "key = value"-pairs as views into \a buffer. So \a buffer must
+ *          outlive the returned data.
+ * \remarks
+ * - Scopes are split in the same way as by parse(). The "key = value"-pairs are kept in the order they appear in
+ *   \a buffer (instead of being sorted by key).
+ * - This function is useful to only look up a few values from a big file without materializing all strings.
+ */
+IniFile::ScopeViewList IniFile::parseViews(std::string_view buffer)
+{
+    auto scopes = ScopeViewList();
+    parseIniFile(buffer, [&scopes](std::string_view sectionName, std::string_view key, std::string_view value) {
+        if (scopes.empty() || scopes.back().first != sectionName) {
+            scopes.emplace_back(sectionName, ScopeViewData());
         }
-
-        // handle eof
-        finishKeyValue();
-    }
+        scopes.back().second.emplace_back(key, value);
+    });
+    return scopes;
 }
 
 /*!
@@ -206,43 +384,82 @@ void IniFile::make(ostream &outputStream)
  * \brief The AdvancedIniFile::Field class represents a field within an INI file.
  */
 
+/*!
+ * \class AdvancedIniFile::SourceRange
+ * \brief The AdvancedIniFile::SourceRange class refers to the data an element has been parsed from.
+ * \remarks
+ * - Only present when parsing with IniFileParseOptions::TrackSource. The range includes the element's preceding
+ *   comment block and everything else since the end of the previous element.
+ * - Adding the source member to AdvancedIniFile::Field and AdvancedIniFile::Section has changed the layout of these
+ *   structs. This breaks the ABI so code using them needs to be recompiled against the new headers.
+ */
+
+/*!
+ * \class AdvancedIniFile::Edit
+ * \brief The AdvancedIniFile::Edit class represents an edit returned by AdvancedIniFile::makeEdits().
+ */
+
 /*!
  * \brief Parses all data from the specified \a inputStream.
  * \remarks
- * Does *not* strip newline and '#' characters from comments. So far there is no option (or separate function) to help with that.
+ * - Does *not* strip newline and '#' characters from comments. So far there is no option (or separate function) to help with that.
+ * - Reads all data into a buffer first and then parses it via parse(std::string_view, IniFileParseOptions).
  * \throws Throws an std::ios_base::failure when an IO error (other than end-of-file) occurs.
  */
-void AdvancedIniFile::parse(std::istream &inputStream, IniFileParseOptions)
+void AdvancedIniFile::parse(std::istream &inputStream, IniFileParseOptions options)
 {
     inputStream.exceptions(ios_base::failbit | ios_base::badbit);
+    parse(readRemainingData(inputStream), options);
+}
 
+/*!
+ * \brief Parses all data from the specified \a buffer.
+ * \remarks
+ * - Does *not* strip newline and '#' characters from comments. So far there is no option (or separate function) to help with that.
+ * - The buffer is scanned for delimiters (instead of processing it char by char) and everything in between is
+ *   appended at once.
+ * - If IniFileParseOptions::TrackSource is specified, the source range of each element within \a buffer is recorded.
+ *   Then make(std::ostream &, std::string_view, IniFileMakeOptions) and makeEdits() can be used to write the data back
+ *   by only re-generating modified elements. The ranges are only meaningful if all sections have been parsed from
+ *   \a buffer (and not via multiple parse() calls).
+ */
+void AdvancedIniFile::parse(std::string_view buffer, IniFileParseOptions options)
+{
     // define variables for state machine
     enum State { Init, CommentBlock, InlineComment, SectionInlineComment, SectionName, SectionEnd, Key, Value } state = Init;
-    char currentCharacter;
 
     // keep track of current comment, section, key and value
     std::string commentBlock, inlineComment, sectionName, key, value;
     std::size_t keyPadding = 0, valuePadding = 0;
-    commentBlock.reserve(256);
-    inlineComment.reserve(256);
-    sectionName.reserve(16);
-    key.reserve(16);
-    value.reserve(256);
+
+    // define function to record the source range of an element; each element's range starts where the previous one ends
+    const auto trackSource = options && IniFileParseOptions::TrackSource;
+    const auto data = buffer.data();
+    auto elementBegin = data;
+    const auto recordSource = [&](auto &element, const char *elementEnd) {
+        if (trackSource) {
+            element.source = SourceRange{ .offset = static_cast<std::size_t>(elementBegin - data),
+                .size = static_cast<std::size_t>(elementEnd - elementBegin),
+                .isPresent = true };
+        }
+        elementBegin = elementEnd;
+    };
 
     // define function to add entry
-    const auto finishKeyValue = [&, this] {
+    const auto finishKeyValue = [&, this](const char *fieldEnd) {
         if (key.empty() && value.empty() && state != Value) {
             return;
         }
         if (sections.empty()) {
-            sections.emplace_back(Section{ .flags = IniFileSectionFlags::Implicit });
+            recordSource(sections.emplace_back(Section{ .flags = IniFileSectionFlags::Implicit }), elementBegin);
         }
-        sections.back().fields.emplace_back(Field{ .key = key,
+        auto &field = sections.back().fields.emplace_back(Field{ .key = key,
             .value = value,
             .precedingCommentBlock = commentBlock,
             .followingInlineComment = inlineComment,
             .paddedKeyLength = key.size() + keyPadding,
             .flags = (!value.empty() || state == Value ? IniFileFieldFlags::HasValue : IniFileFieldFlags::None) });
+        recordSource(field, fieldEnd);
         key.clear();
         value.clear();
         commentBlock.clear();
@@ -250,153 +467,169 @@ void AdvancedIniFile::parse(std::istream &inputStream, IniFileParseOptions)
         keyPadding = valuePadding = 0;
     };
 
-    // parse the file char by char
-    try {
-        while (inputStream.get(currentCharacter)) {
-            // handle next character
-            switch (state) {
-            case Init:
-                switch (currentCharacter) {
-                case '\n':
-                    commentBlock += currentCharacter;
-                    break;
-                case '#':
-                    commentBlock += currentCharacter;
-                    state = CommentBlock;
-                    break;
-                case '=':
-                    keyPadding = valuePadding = 0;
-                    state = Value;
-                    break;
-                case '[':
-                    sectionName.clear();
-                    state = SectionName;
-                    break;
-                default:
-                    addChar(currentCharacter, key, keyPadding);
-                    state = Key;
-                }
+    // parse the buffer; states which consume many chars handle all chars until the next relevant delimiter at once
+    for (auto i = buffer.data(), end = buffer.data() + buffer.size(); i != end; ++i) {
+        switch (state) {
+        case Init:
+            switch (*i) {
+            case '\n':
+                commentBlock += *i;
                 break;
-            case Key:
-                switch (currentCharacter) {
-                case '\n':
-                    finishKeyValue();
-                    state = Init;
-                    break;
-                case '#':
-                    state = InlineComment;
-                    inlineComment += currentCharacter;
-                    break;
-                case '=':
-                    valuePadding = 0;
-                    state = Value;
-                    break;
-                default:
-                    addChar(currentCharacter, key, keyPadding);
-                }
+            case '#':
+                commentBlock += *i;
+                state = CommentBlock;
                 break;
-            case CommentBlock:
-                switch (currentCharacter) {
-                case '\n':
-                    state = Init;
-                    [[fallthrough]];
-                default:
-                    commentBlock += currentCharacter;
-                }
+            case '=':
+                keyPadding = valuePadding = 0;
+                state = Value;
                 break;
-            case InlineComment:
-            case SectionInlineComment:
-                switch (currentCharacter) {
-                case '\n':
-                    switch (state) {
-                    case InlineComment:
-                        finishKeyValue();
-                        break;
-                    case SectionInlineComment:
-                        sections.back().followingInlineComment = inlineComment;
-                        inlineComment.clear();
-                        break;
-                    default:;
-                    }
-                    state = Init;
-                    break;
-                default:
-                    inlineComment += currentCharacter;
-                }
+            case '[':
+                sectionName.clear();
+                state = SectionName;
                 break;
-            case SectionName:
-                switch (currentCharacter) {
-                case ']':
-                    state = SectionEnd;
-                    sections.emplace_back(Section{ .name = sectionName });
-                    sections.back().precedingCommentBlock = commentBlock;
-                    sectionName.clear();
-                    commentBlock.clear();
-                    break;
-                default:
-                    sectionName += currentCharacter;
-                }
+            default:
+                addChars(std::string_view(i, 1), key, keyPadding);
+                state = Key;
+            }
+            break;
+        case Key: {
+            const auto delimiter = findFirstOf(i, end, '\n', '#', '=');
+            addChars(std::string_view(i, static_cast<std::size_t>(delimiter - i)), key, keyPadding);
+            if ((i = delimiter) == end) {
+                --i;
                 break;
-            case SectionEnd:
-                switch (currentCharacter) {
-                case '\n':
-                    state = Init;
-                    break;
-                case '#':
-                    state = SectionInlineComment;
-                    inlineComment += currentCharacter;
-                    break;
-                case '=':
-                    keyPadding = valuePadding = 0;
-                    state = Value;
-                    break;
-                case ' ':
-                    break;
-                default:
-                    state = Key;
-                    addChar(currentCharacter, key, keyPadding);
-                }
+            }
+            switch (*i) {
+            case '\n':
+                finishKeyValue(i + 1);
+                state = Init;
                 break;
-            case Value:
-                switch (currentCharacter) {
-                case '\n':
-                    finishKeyValue();
-                    state = Init;
-                    break;
-                case '#':
-                    state = InlineComment;
-                    inlineComment += currentCharacter;
-                    break;
-                default:
-                    addChar(currentCharacter, value, valuePadding);
-                }
+            case '#':
+                state = InlineComment;
+                inlineComment += *i;
                 break;
+            default:
+                valuePadding = 0;
+                state = Value;
             }
+            break;
         }
-    } catch (const std::ios_base::failure &) {
-        if (!inputStream.eof()) {
-            throw;
+        case CommentBlock: {
+            const auto lineEnd = findChar(i, end, '\n');
+            if (lineEnd != end) {
+                state = Init;
+            }
+            commentBlock.append(i, lineEnd != end ? lineEnd + 1 : end);
+            i = lineEnd != end ? lineEnd : end - 1;
+            break;
         }
-
-        // handle eof
-        switch (state) {
-        case Init:
-        case CommentBlock:
-            sections.emplace_back(Section{ .precedingCommentBlock = commentBlock, .flags = IniFileSectionFlags::Implicit });
+        case InlineComment:
+        case SectionInlineComment: {
+            const auto lineEnd = findChar(i, end, '\n');
+            inlineComment.append(i, lineEnd);
+            if ((i = lineEnd) == end) {
+                --i;
+                break;
+            }
+            if (state == InlineComment) {
+                finishKeyValue(i + 1);
+            } else {
+                sections.back().followingInlineComment = inlineComment;
+                inlineComment.clear();
+                recordSource(sections.back(), i + 1);
+            }
+            state = Init;
             break;
-        case SectionName:
-            sections.emplace_back(Section{ .name = sectionName, .precedingCommentBlock = commentBlock, .flags = IniFileSectionFlags::Implicit });
+        }
+        case SectionName: {
+            const auto sectionNameEnd = findChar(i, end, ']');
+            sectionName.append(i, sectionNameEnd);
+            if ((i = sectionNameEnd) == end) {
+                --i;
+                break;
+            }
+            state = SectionEnd;
+            sections.emplace_back(Section{ .name = sectionName });
+            sections.back().precedingCommentBlock = commentBlock;
+            sectionName.clear();
+            commentBlock.clear();
             break;
+        }
         case SectionEnd:
-        case SectionInlineComment:
-            sections.emplace_back(Section{ .name = sectionName, .precedingCommentBlock = commentBlock, .followingInlineComment = inlineComment });
+            switch (*i) {
+            case '\n':
+                state = Init;
+                recordSource(sections.back(), i + 1);
+                break;
+            case '#':
+                state = SectionInlineComment;
+                inlineComment += *i;
+                break;
+            case '=':
+                keyPadding = valuePadding = 0;
+                state = Value;
+                recordSource(sections.back(), i);
+                break;
+            case ' ':
+                break;
+            default:
+                state = Key;
+                recordSource(sections.back(), i);
+                addChars(std::string_view(i, 1), key, keyPadding);
+            }
             break;
-        case Key:
-        case Value:
-        case InlineComment:
-            finishKeyValue();
+        case Value: {
+            const auto delimiter = findFirstOf(i, end, '\n', '#');
+            addChars(std::string_view(i, static_cast<std::size_t>(delimiter - i)), value, valuePadding);
+            if ((i = delimiter) == end) {
+                --i;
+                break;
+            }
+            if (*i == '\n') {
+                finishKeyValue(i + 1);
+                state = Init;
+            } else {
+                state = InlineComment;
+                inlineComment += *i;
+            }
             break;
         }
+        }
+    }
+
+    // handle end of buffer
+    const auto end = data + buffer.size();
+    switch (state) {
+    case Init:
+    case CommentBlock:
+        recordSource(sections.emplace_back(Section{ .precedingCommentBlock = commentBlock, .flags = IniFileSectionFlags::Implicit }), end);
+        break;
+    case SectionName:
+        recordSource(sections.emplace_back(
+                         Section{ .name = sectionName, .precedingCommentBlock = commentBlock, .flags = IniFileSectionFlags::Implicit }),
+            end);
+        break;
+    case SectionEnd:
+    case SectionInlineComment:
+        recordSource(sections.back(), end);
+        recordSource(sections.emplace_back(
+                         Section{ .name = sectionName, .precedingCommentBlock = commentBlock, .followingInlineComment = inlineComment }),
+            end);
+        break;
+    case Key:
+    case Value:
+    case InlineComment:
+        finishKeyValue(end);
+        break;
+    }
+
+    // assign remaining data not belonging to any element (e.g. trailing spaces) to the last element
+    if (trackSource && elementBegin != end && !sections.empty()) {
+        auto &lastSection = sections.back();
+        auto &lastSource = lastSection.fields.empty() ? lastSection.source : lastSection.fields.back().source;
+        if (lastSource.isPresent && lastSource.offset + lastSource.size == static_cast<std::size_t>(elementBegin - data)) {
+            lastSource.size += static_cast<std::size_t>(end - elementBegin);
+        }
     }
 }
 
@@ -410,37 +643,502 @@ void AdvancedIniFile::parse(std::istream &inputStream, IniFileParseOptions)
 void AdvancedIniFile::make(ostream &outputStream, IniFileMakeOptions)
 {
     outputStream.exceptions(ios_base::failbit | ios_base::badbit);
+    auto buffer = std::string();
     for (const auto &section : sections) {
-        if (!section.precedingCommentBlock.empty()) {
-            outputStream << section.precedingCommentBlock;
+        buffer.clear();
+        appendElement(buffer, section);
+        for (const auto &field : section.fields) {
+            appendElement(buffer, field);
+        }
+        outputStream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    }
+}
+
+/*!
+ * \brief Write the current data to the specified \a outputStream copying unmodified elements from \a source.
+ * \throws Throws an std::ios_base::failure when an IO error occurs.
+ * \remarks
+ * - The data must have been parsed from \a source via parse() using IniFileParseOptions::TrackSource. Elements which
+ *   have not been modified since then are copied verbatim from \a source (preserving formatting make() would not
+ *   preserve). Modified and new elements are written like make() writes them.
+ * - Modifications are detected by comparing each element with the element parsed from its source range (so \a source
+ *   is parsed again).
+ */
+void AdvancedIniFile::make(ostream &outputStream, std::string_view source, IniFileMakeOptions) const
+{
+    outputStream.exceptions(ios_base::failbit | ios_base::badbit);
+    forEachPiece(*this, source, [&outputStream](const SourceRange *, std::string_view piece) {
+        outputStream.write(piece.data(), static_cast<std::streamsize>(piece.size()));
+    });
+}
+
+/*!
+ * \brief Returns the edits required to turn \a source into the current data.
+ * \returns Returns the edits ordered by their offset. They do not overlap. Each edit replaces \a size bytes at \a offset
+ *          within \a source with \a replacement.
+ * \remarks
+ * - The data must have been parsed from \a source via parse() using IniFileParseOptions::TrackSource. See
+ *   make(std::ostream &, std::string_view, IniFileMakeOptions) for details.
+ * - Applying the edits via applyEdits() results in the same data make(std::ostream &, std::string_view, IniFileMakeOptions)
+ *   would write. When only a few elements have been modified the edits are tiny compared to the whole file so they
+ *   can be written efficiently, e.g. by rewriting the file only from the first edit on.
+ */
+std::vector<AdvancedIniFile::Edit> AdvancedIniFile::makeEdits(std::string_view source, IniFileMakeOptions) const
+{
+    auto edits = std::vector<Edit>();
+    auto pendingEdit = Edit();
+    auto hasPendingEdit = false;
+    auto consumedSize = std::size_t(); // number of bytes of source covered by the edits and unmodified elements so far
+    const auto finishEdit = [&](std::size_t nextUnmodifiedOffset) {
+        if (!hasPendingEdit) {
+            pendingEdit.offset = consumedSize;
+            pendingEdit.replacement.clear();
         }
-        if (!(section.flags && IniFileSectionFlags::Implicit)) {
-            outputStream << '[' << section.name << ']';
-            if (!section.followingInlineComment.empty()) {
-                outputStream << ' ' << section.followingInlineComment;
+        pendingEdit.size = nextUnmodifiedOffset - pendingEdit.offset;
+        if (pendingEdit.size || !pendingEdit.replacement.empty()) {
+            edits.emplace_back(std::move(pendingEdit));
+        }
+        pendingEdit = Edit();
+        hasPendingEdit = false;
+    };
+    forEachPiece(*this, source, [&](const SourceRange *sourceRange, std::string_view piece) {
+        if (sourceRange && sourceRange->offset >= consumedSize) {
+            // replace/remove everything between the previous unmodified element and this one
+            if (hasPendingEdit || sourceRange->offset > consumedSize) {
+                finishEdit(sourceRange->offset);
             }
-            outputStream << '\n';
+            consumedSize = sourceRange->offset + sourceRange->size;
+            return;
         }
-        for (const auto &field : section.fields) {
-            if (!field.precedingCommentBlock.empty()) {
-                outputStream << field.precedingCommentBlock;
+        // insert modified element (or unmodified element which has been moved before its original position)
+        if (!hasPendingEdit) {
+            pendingEdit.offset = consumedSize;
+            hasPendingEdit = true;
+        }
+        pendingEdit.replacement.append(piece);
+    });
+    if (hasPendingEdit || consumedSize < source.size()) {
+        finishEdit(source.size());
+    }
+    return edits;
+}
+
+/*!
+ * \brief Applies the specified \a edits (as returned by makeEdits()) to \a source.
+ */
+void AdvancedIniFile::applyEdits(std::string &source, const std::vector<Edit> &edits)
+{
+    for (auto edit = edits.rbegin(), end = edits.rend(); edit != end; ++edit) {
+        source.replace(edit->offset, edit->size, edit->replacement);
+    }
+}
+
+/*!
+ * \class AdvancedIniFileIndex
+ * \brief The AdvancedIniFileIndex class allows looking up sections and fields of an AdvancedIniFile in constant time.
+ *
+ * The find functions of AdvancedIniFile and AdvancedIniFile::Section scan the sections/fields linearly. This is fine for
+ * small files but becomes slow when querying large files many times. This class provides the same find functions
+ * (with the same semantics regarding order and duplicates) using hash tables instead.
+ *
+ * The hash tables are built lazily on the first lookup (the field table of a section on the first lookup within that
+ * section). The index is not notified when the sections/fields are modified. So invalidate() must be called after adding,
+ * removing, renaming or reordering sections/fields (e.g. via AdvancedIniFile::parse()). Otherwise lookups might return
+ * wrong results.
+ *
+ * \remarks Lookups rebuild a hash table when the number of sections/fields or their storage location has changed. This
+ *          only avoids out-of-bounds accesses and does not replace calling invalidate(). For instance, erasing a field
+ *          and adding another one keeps the number of fields and usually also their storage location.
+ */
+
+/// \cond
+constexpr auto noPosition = std::numeric_limits<std::size_t>::max();
+
+static const std::string &sectionName(const AdvancedIniFile::Section &section)
+{
+    return section.name;
+}
+
+static const std::string &fieldKey(const AdvancedIniFile::Field &field)
+{
+    return field.key;
+}
+
+static std::size_t hashName(std::string_view name)
+{
+    return std::hash<std::string_view>()(name);
+}
+
+template <typename List> static bool isNameIndexUpToDate(const AdvancedIniFileIndex::NameIndex &index, const List &list)
+{
+    return index.isBuilt && index.data == list.data() && index.size == list.size();
+}
+
+template <typename List, typename NameGetter>
+static void buildNameIndex(AdvancedIniFileIndex::NameIndex &index, const List &list, NameGetter nameOf)
+{
+    index.firstPositionByHash.clear();
+    index.firstPositionByHash.reserve(list.size());
+    index.nextPositionWithSameHash.assign(list.size(), noPosition);
+    // insert backwards so the positions with the same hash are chained in ascending order
+    for (auto position = list.size(); position-- > 0;) {
+        const auto [i, inserted] = index.firstPositionByHash.try_emplace(hashName(nameOf(list[position])), position);
+        if (!inserted) {
+            index.nextPositionWithSameHash[position] = i->second;
+            i->second = position;
+        }
+    }
+    index.data = list.data();
+    index.size = list.size();
+    index.isBuilt = true;
+}
+
+template <typename List, typename NameGetter>
+static std::size_t findInNameIndex(
+    const AdvancedIniFileIndex::NameIndex &index, const List &list, NameGetter nameOf, std::size_t after, std::string_view name)
+{
+    auto position = noPosition;
+    if (after < list.size() && nameOf(list[after]) == name) {
+        // continue with the next position with the same name (common when iterating over duplicates)
+        position = index.nextPositionWithSameHash[after];
+    } else if (const auto i = index.firstPositionByHash.find(hashName(name)); i != index.firstPositionByHash.end()) {
+        position = i->second;
+        for (; position != noPosition && after != noPosition && position <= after; position = index.nextPositionWithSameHash[position])
+            ;
+    }
+    // skip positions with colliding hashes
+    for (; position != noPosition && nameOf(list[position]) != name; position = index.nextPositionWithSameHash[position])
+        ;
+    return position;
+}
+/// \endcond
+
+/*!
+ * \brief Returns an iterator to the first section with the name \a sectionName.
+ * \sa AdvancedIniFile::findSection()
+ */
+AdvancedIniFile::SectionList::iterator AdvancedIniFileIndex::findSection(std::string_view sectionName)
+{
+    return findSection(m_file->sectionEnd(), sectionName);
+}
+
+/*!
+ * \brief Returns an iterator to the first section with the name \a sectionName which comes after \a after.
+ * \remarks Searches from the beginning if \a after is AdvancedIniFile::sectionEnd().
+ * \sa AdvancedIniFile::findSection()
+ */
+AdvancedIniFile::SectionList::iterator AdvancedIniFileIndex::findSection(AdvancedIniFile::SectionList::iterator after, std::string_view sectionName)
+{
+    auto &sections = m_file->sections;
+    updateSectionIndex();
+    const auto afterPosition = after == sections.end() ? noPosition : static_cast<std::size_t>(after - sections.begin());
+    const auto position = findInNameIndex(m_sectionIndex, sections, CppUtilities::sectionName, afterPosition, sectionName);
+    return position == noPosition ? sections.end() : sections.begin() + static_cast<std::ptrdiff_t>(position);
+}
+
+/*!
+ * \brief Returns an iterator to the first field with the key \a key within \a section.
+ * \sa AdvancedIniFile::Section::findField()
+ */
+AdvancedIniFile::FieldList::iterator AdvancedIniFileIndex::findField(AdvancedIniFile::SectionList::iterator section, std::string_view key)
+{
+    return findField(section, section->fieldEnd(), key);
+}
+
+/*!
+ * \brief Returns an iterator to the first field with the key \a key within \a section which comes after \a after.
+ * \remarks Searches from the beginning if \a after is AdvancedIniFile::Section::fieldEnd().
+ * \sa AdvancedIniFile::Section::findField()
+ */
+AdvancedIniFile::FieldList::iterator AdvancedIniFileIndex::findField(
+    AdvancedIniFile::SectionList::iterator section, AdvancedIniFile::FieldList::iterator after, std::string_view key)
+{
+    auto &sections = m_file->sections;
+    updateSectionIndex();
+    auto &fields = section->fields;
+    auto &fieldIndex = m_fieldIndexes[static_cast<std::size_t>(section - sections.begin())];
+    if (!isNameIndexUpToDate(fieldIndex, fields)) {
+        buildNameIndex(fieldIndex, fields, fieldKey);
+    }
+    const auto afterPosition = after == fields.end() ? noPosition : static_cast<std::size_t>(after - fields.begin());
+    const auto position = findInNameIndex(fieldIndex, fields, fieldKey, afterPosition, key);
+    return position == noPosition ? fields.end() : fields.begin() + static_cast<std::ptrdiff_t>(position);
+}
+
+/*!
+ * \brief Rebuilds the hash table for the sections (and discards the ones for the fields) if it has been invalidated or the
+ *        number/location of the sections has changed.
+ */
+void AdvancedIniFileIndex::updateSectionIndex()
+{
+    const auto &sections = m_file->sections;
+    if (!isNameIndexUpToDate(m_sectionIndex, sections)) {
+        buildNameIndex(m_sectionIndex, sections, CppUtilities::sectionName);
+        m_fieldIndexes.clear();
+        m_fieldIndexes.resize(sections.size());
+    }
+}
+
+/*!
+ * \brief Discards all hash tables so they are rebuilt on the next lookup.
+ * \remarks Must be called after adding, removing, renaming or reordering sections or fields.
+ */
+void AdvancedIniFileIndex::invalidate()
+{
+    m_sectionIndex.isBuilt = false;
+    m_fieldIndexes.clear();
+}
+
+/*!
+ * \class IniFileLoader
+ * \brief The IniFileLoader class loads INI files resolving include directives like "Include = /etc/pacman.d/mirrorlist".
+ *
+ * - Fields with the include key are replaced by the fields of the included file. Fields within the global scope of the
+ *   included file are merged into the scope containing the directive. Other scopes of the included file are added as
+ *   separate scopes. Since IniFile does not preserve the order of fields with different keys, the fields of included
+ *   files are always added after the other fields of the scope containing the directive.
+ * - Relative include paths are resolved relative to the directory of the including file. Glob patterns are not supported.
+ * - Includes are resolved recursively. Include directives which would lead to a cycle are ignored.
+ * - All files required by a load() call are parsed in parallel (level by level as includes are discovered).
+ * - Parsed files are cached by their path and re-parsed when their modification time or size changes. So loading many
+ *   files sharing the same includes parses the shared files only once. (The cache is only effective if the library has
+ *   been built with std::filesystem support.)
+ * - The loader can be used from multiple threads at the same time.
+ */
+
+/// \cond
+struct IniFileStatus {
+    std::int64_t modificationTime = 0;
+    std::uintmax_t size = 0;
+    bool isKnown = false;
+};
+
+/*!
+ * \brief Returns the modification time and size of the file at \a path.
+ * \throws Throws an std::ios_base::failure if the status cannot be determined.
+ */
+static IniFileStatus iniFileStatus(const std::string &path)
+{
+#ifdef CPP_UTILITIES_USE_STANDARD_FILESYSTEM
+    auto ec = std::error_code();
+    const auto nativePath = std::filesystem::path(makeNativePath(path));
+    const auto modificationTime = std::filesystem::last_write_time(nativePath, ec);
+    if (ec) {
+        throw std::ios_base::failure("unable to determine modification time of \"" + path + '\"', ec);
+    }
+    const auto size = std::filesystem::file_size(nativePath, ec);
+    if (ec) {
+        throw std::ios_base::failure("unable to determine size of \"" + path + '\"', ec);
+    }
+    return IniFileStatus{ .modificationTime = static_cast<std::int64_t>(modificationTime.time_since_epoch().count()), .size = size, .isKnown = true };
+#else
+    CPP_UTILITIES_UNUSED(path)
+    return IniFileStatus();
+#endif
+}
+
+/*!
+ * \brief Returns the normalized path of \a includePath which might be relative to the directory of \a includingPath.
+ */
+static std::string resolveIncludePath(std::string_view includingPath, std::string_view includePath)
+{
+    auto resolvedPath = std::string();
+    const auto isAbsolute = !includePath.empty()
+        && (PathComponentIterator::isSeparator(includePath.front()) || (includePath.size() > 1 && includePath[1] == ':'));
+    if (!isAbsolute) {
+        resolvedPath = directory(includingPath);
+    }
+    resolvedPath += includePath;
+    normalizePath(resolvedPath);
+    return resolvedPath;
+}
+
+/*!
+ * \brief Calls \a function for the indexes [0, \a count) using up to \a threadCount threads.
+ * \throws Rethrows the first exception thrown by \a function (after all threads have been joined).
+ */
+template <typename Function> static void runInParallel(std::size_t count, std::size_t threadCount, Function &&function)
+{
+    auto nextIndex = std::atomic<std::size_t>();
+    auto exception = std::exception_ptr();
+    auto exceptionMutex = std::mutex();
+    const auto work = [&] {
+        for (auto index = nextIndex++; index < count; index = nextIndex++) {
+            try {
+                function(index);
+            } catch (...) {
+                const auto lock = std::lock_guard<std::mutex>(exceptionMutex);
+                if (!exception) {
+                    exception = std::current_exception();
+                }
+                nextIndex = count;
             }
-            outputStream << field.key;
-            for (auto charsWritten = field.key.size(); charsWritten < field.paddedKeyLength; ++charsWritten) {
-                outputStream << ' ';
+        }
+    };
+    auto threads = std::vector<std::thread>();
+    const auto workerCount = std::min(threadCount, count);
+    threads.reserve(workerCount);
+    for (auto i = std::size_t(1); i < workerCount; ++i) {
+        try {
+            threads.emplace_back(work);
+        } catch (const std::system_error &) {
+            break; // just continue with the threads we have
+        }
+    }
+    work();
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    if (exception) {
+        std::rethrow_exception(exception);
+    }
+}
+
+/*!
+ * \brief Adds the data of the file at \a path to \a result resolving include directives recursively.
+ */
+static void mergeIniFile(const std::unordered_map<std::string, IniFileLoader::CachedFile> &files, const std::string &includeKey,
+    const std::string &path, const std::string *targetScopeName, IniFile::ScopeList &result, std::vector<const std::string *> &includeStack)
+{
+    includeStack.emplace_back(&path);
+    for (const auto &[scopeName, fields] : files.at(path).file->data()) {
+        const auto &name = targetScopeName && scopeName.empty() ? *targetScopeName : scopeName;
+        for (const auto &[key, value] : fields) {
+            if (key == includeKey) {
+                continue;
             }
-            if (field.flags && IniFileFieldFlags::HasValue) {
-                outputStream << '=' << ' ' << field.value;
+            if (result.empty() || result.back().first != name) {
+                result.emplace_back(name, IniFile::ScopeData());
             }
-            if (!field.followingInlineComment.empty()) {
-                if (field.flags && IniFileFieldFlags::HasValue) {
-                    outputStream << ' ';
-                }
-                outputStream << field.followingInlineComment;
+            result.back().second.emplace(key, value);
+        }
+        for (auto [field, end] = fields.equal_range(includeKey); field != end; ++field) {
+            const auto includePath = resolveIncludePath(path, field->second);
+            if (std::none_of(includeStack.begin(), includeStack.end(), [&includePath](const std::string *p) { return *p == includePath; })) {
+                mergeIniFile(files, includeKey, files.find(includePath)->first, &name, result, includeStack);
+            }
+        }
+    }
+    includeStack.pop_back();
+}
+/// \endcond
+
+/*!
+ * \brief Constructs a new loader.
+ * \param includeKey Specifies the key of fields which are treated as include directives.
+ * \param threadCount Specifies the max. number of threads used to parse files in parallel. If zero, the number of
+ *        hardware threads is used.
+ */
+IniFileLoader::IniFileLoader(std::string_view includeKey, std::size_t threadCount)
+    : m_includeKey(includeKey)
+    , m_threadCount(threadCount ? threadCount : std::max<std::size_t>(std::thread::hardware_concurrency(), 1))
+{
+}
+
+/*!
+ * \brief Loads the INI file at \a path resolving include directives.
+ * \throws Throws an std::ios_base::failure when an IO error occurs (e.g. an included file does not exist).
+ */
+IniFile IniFileLoader::load(std::string_view path)
+{
+    return std::move(load(std::vector<std::string>{ std::string(path) }).front());
+}
+
+/*!
+ * \brief Loads the INI files at the specified \a paths resolving include directives.
+ * \returns Returns the loaded files in the order of \a paths.
+ * \throws Throws an std::ios_base::failure when an IO error occurs (e.g. an included file does not exist).
+ */
+std::vector<IniFile> IniFileLoader::load(const std::vector<std::string> &paths)
+{
+    // load the specified files and their includes level by level; the files of one level are loaded in parallel
+    auto files = std::unordered_map<std::string, CachedFile>();
+    auto normalizedPaths = std::vector<const std::string *>();
+    auto pendingPaths = std::vector<const std::string *>();
+    auto pendingFiles = std::vector<CachedFile *>();
+    normalizedPaths.reserve(paths.size());
+    const auto addPendingFile = [&](std::string &&path) {
+        const auto [file, isNew] = files.try_emplace(std::move(path));
+        if (isNew) {
+            pendingPaths.emplace_back(&file->first);
+            pendingFiles.emplace_back(&file->second);
+        }
+        return &file->first;
+    };
+    for (const auto &path : paths) {
+        auto normalizedPath = path;
+        normalizePath(normalizedPath);
+        normalizedPaths.emplace_back(addPendingFile(std::move(normalizedPath)));
+    }
+    while (!pendingPaths.empty()) {
+        const auto levelPaths = std::move(pendingPaths);
+        const auto levelFiles = std::move(pendingFiles);
+        pendingPaths.clear();
+        pendingFiles.clear();
+        runInParallel(levelPaths.size(), m_threadCount, [&](std::size_t index) { *levelFiles[index] = loadFile(*levelPaths[index]); });
+        for (const auto *const file : levelFiles) {
+            for (const auto &includePath : file->includes) {
+                addPendingFile(std::string(includePath));
             }
-            outputStream << '\n';
         }
     }
+
+    // merge included files
+    auto results = std::vector<IniFile>(paths.size());
+    auto includeStack = std::vector<const std::string *>();
+    for (auto i = std::size_t(); i != paths.size(); ++i) {
+        mergeIniFile(files, m_includeKey, *normalizedPaths[i], nullptr, results[i].data(), includeStack);
+    }
+    return results;
+}
+
+/*!
+ * \brief Returns the number of parsed files currently cached.
+ */
+std::size_t IniFileLoader::cachedFileCount() const
+{
+    const auto lock = std::lock_guard<std::mutex>(m_cacheMutex);
+    return m_cache.size();
+}
+
+/*!
+ * \brief Clears the cache so all files are parsed again on the next load() call.
+ */
+void IniFileLoader::clearCache()
+{
+    const auto lock = std::lock_guard<std::mutex>(m_cacheMutex);
+    m_cache.clear();
+}
+
+/*!
+ * \brief Returns the parsed file at \a path from the cache or parses it if not cached or outdated.
+ */
+IniFileLoader::CachedFile IniFileLoader::loadFile(const std::string &path)
+{
+    const auto status = iniFileStatus(path);
+    if (status.isKnown) {
+        const auto lock = std::lock_guard<std::mutex>(m_cacheMutex);
+        const auto cachedFile = m_cache.find(path);
+        if (cachedFile != m_cache.end() && cachedFile->second.modificationTime == status.modificationTime
+            && cachedFile->second.size == status.size) {
+            return cachedFile->second;
+        }
+    }
+    auto file = std::make_shared<IniFile>();
+    file->parse(std::string_view(readFile(path)));
+    auto includes = std::vector<std::string>();
+    for (const auto &scope : file->data()) {
+        for (auto [field, end] = scope.second.equal_range(m_includeKey); field != end; ++field) {
+            includes.emplace_back(resolveIncludePath(path, field->second));
+        }
+    }
+    auto loadedFile = CachedFile{
+        .modificationTime = status.modificationTime, .size = status.size, .file = std::move(file), .includes = std::move(includes) };
+    if (status.isKnown) {
+        const auto lock = std::lock_guard<std::mutex>(m_cacheMutex);
+        m_cache[path] = loadedFile;
+    }
+    return loadedFile;
 }
 
 } // namespace CppUtilities
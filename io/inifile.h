@@ -5,10 +5,15 @@
 #include "../misc/flagenumclass.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <iosfwd>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace CppUtilities {
@@ -19,11 +24,16 @@ public:
     using ScopeData = std::multimap<std::string, std::string>;
     using Scope = std::pair<ScopeName, ScopeData>;
     using ScopeList = std::vector<Scope>;
+    using ScopeViewData = std::vector<std::pair<std::string_view, std::string_view>>;
+    using ScopeView = std::pair<std::string_view, ScopeViewData>;
+    using ScopeViewList = std::vector<ScopeView>;
 
     IniFile();
     ScopeList &data();
     const ScopeList &data() const;
     void parse(std::istream &inputStream);
+    void parse(std::string_view buffer);
+    static ScopeViewList parseViews(std::string_view buffer);
     void make(std::ostream &outputStream);
 
 private:
@@ -57,8 +67,54 @@ inline const IniFile::ScopeList &IniFile::data() const
     return m_data;
 }
 
+class CPP_UTILITIES_EXPORT IniFileLoader {
+public:
+    explicit IniFileLoader(std::string_view includeKey = "Include", std::size_t threadCount = 0);
+
+    const std::string &includeKey() const;
+    std::size_t threadCount() const;
+    IniFile load(std::string_view path);
+    std::vector<IniFile> load(const std::vector<std::string> &paths);
+    std::size_t cachedFileCount() const;
+    void clearCache();
+
+    /// \cond
+    struct CachedFile {
+        std::int64_t modificationTime = 0;
+        std::uintmax_t size = 0;
+        std::shared_ptr<const IniFile> file;
+        std::vector<std::string> includes;
+    };
+    /// \endcond
+
+private:
+    CachedFile loadFile(const std::string &path);
+
+    std::string m_includeKey;
+    std::size_t m_threadCount;
+    std::unordered_map<std::string, CachedFile> m_cache;
+    mutable std::mutex m_cacheMutex;
+};
+
+/*!
+ * \brief Returns the key of fields which are treated as include directives.
+ */
+inline const std::string &IniFileLoader::includeKey() const
+{
+    return m_includeKey;
+}
+
+/*!
+ * \brief Returns the max. number of threads used to parse files in parallel.
+ */
+inline std::size_t IniFileLoader::threadCount() const
+{
+    return m_threadCount;
+}
+
 enum class IniFileParseOptions {
     None = 0,
+    TrackSource = (1 << 0), /**< record the source range of each element so AdvancedIniFile::makeEdits() can be used */
 };
 
 enum class IniFileMakeOptions {
@@ -77,6 +133,11 @@ enum class IniFileSectionFlags {
 };
 
 struct CPP_UTILITIES_EXPORT AdvancedIniFile {
+    struct SourceRange {
+        std::size_t offset = 0;
+        std::size_t size = 0;
+        bool isPresent = false;
+    };
     struct Field {
         std::string key;
         std::string value;
@@ -84,6 +145,7 @@ struct CPP_UTILITIES_EXPORT AdvancedIniFile {
         std::string followingInlineComment;
         std::size_t paddedKeyLength = 0;
         IniFileFieldFlags flags = IniFileFieldFlags::HasValue;
+        SourceRange source = SourceRange();
     };
     using FieldList = std::vector<Field>;
     struct Section {
@@ -99,8 +161,14 @@ struct CPP_UTILITIES_EXPORT AdvancedIniFile {
         std::string precedingCommentBlock;
         std::string followingInlineComment;
         IniFileSectionFlags flags = IniFileSectionFlags::None;
+        SourceRange source = SourceRange();
     };
     using SectionList = std::vector<Section>;
+    struct Edit {
+        std::size_t offset = 0;
+        std::size_t size = 0;
+        std::string replacement;
+    };
 
     SectionList::iterator findSection(std::string_view sectionName);
     SectionList::const_iterator findSection(std::string_view sectionName) const;
@@ -111,7 +179,11 @@ struct CPP_UTILITIES_EXPORT AdvancedIniFile {
     std::optional<FieldList::iterator> findField(std::string_view sectionName, std::string_view key);
     std::optional<FieldList::const_iterator> findField(std::string_view sectionName, std::string_view key) const;
     void parse(std::istream &inputStream, IniFileParseOptions options = IniFileParseOptions::None);
+    void parse(std::string_view buffer, IniFileParseOptions options = IniFileParseOptions::None);
     void make(std::ostream &outputStream, IniFileMakeOptions options = IniFileMakeOptions::None);
+    void make(std::ostream &outputStream, std::string_view source, IniFileMakeOptions options = IniFileMakeOptions::None) const;
+    std::vector<Edit> makeEdits(std::string_view source, IniFileMakeOptions options = IniFileMakeOptions::None) const;
+    static void applyEdits(std::string &source, const std::vector<Edit> &edits);
 
     SectionList sections;
 };
@@ -236,6 +308,79 @@ inline AdvancedIniFile::FieldList::const_iterator AdvancedIniFile::Section::fiel
     return fields.end();
 }
 
+class CPP_UTILITIES_EXPORT AdvancedIniFileIndex {
+public:
+    explicit AdvancedIniFileIndex(AdvancedIniFile &file);
+
+    AdvancedIniFile &file();
+    const AdvancedIniFile &file() const;
+    AdvancedIniFile::SectionList::iterator findSection(std::string_view sectionName);
+    AdvancedIniFile::SectionList::iterator findSection(AdvancedIniFile::SectionList::iterator after, std::string_view sectionName);
+    AdvancedIniFile::FieldList::iterator findField(AdvancedIniFile::SectionList::iterator section, std::string_view key);
+    AdvancedIniFile::FieldList::iterator findField(
+        AdvancedIniFile::SectionList::iterator section, AdvancedIniFile::FieldList::iterator after, std::string_view key);
+    std::optional<AdvancedIniFile::FieldList::iterator> findField(std::string_view sectionName, std::string_view key);
+    void invalidate();
+
+    /// \cond
+    struct NameIndex {
+        std::unordered_map<std::size_t, std::size_t> firstPositionByHash;
+        std::vector<std::size_t> nextPositionWithSameHash;
+        const void *data = nullptr;
+        std::size_t size = 0;
+        bool isBuilt = false;
+    };
+    /// \endcond
+
+private:
+    void updateSectionIndex();
+
+    AdvancedIniFile *m_file;
+    NameIndex m_sectionIndex;
+    std::vector<NameIndex> m_fieldIndexes;
+};
+
+/*!
+ * \brief Constructs a new index for the specified \a file.
+ * \remarks The index is not built until the first lookup. The \a file must outlive the index.
+ */
+inline AdvancedIniFileIndex::AdvancedIniFileIndex(AdvancedIniFile &file)
+    : m_file(&file)
+{
+}
+
+/*!
+ * \brief Returns the indexed file.
+ */
+inline AdvancedIniFile &AdvancedIniFileIndex::file()
+{
+    return *m_file;
+}
+
+/*!
+ * \brief Returns the indexed file.
+ */
+inline const AdvancedIniFile &AdvancedIniFileIndex::file() const
+{
+    return *m_file;
+}
+
+/*!
+ * \brief Returns an iterator to the first field within the first section with matching \a sectionName and \a key.
+ */
+inline std::optional<AdvancedIniFile::FieldList::iterator> AdvancedIniFileIndex::findField(std::string_view sectionName, std::string_view key)
+{
+    const auto section = findSection(sectionName);
+    if (section == m_file->sectionEnd()) {
+        return std::nullopt;
+    }
+    const auto field = findField(section, key);
+    if (field == section->fieldEnd()) {
+        return std::nullopt;
+    }
+    return field;
+}
+
 } // namespace CppUtilities
 
 CPP_UTILITIES_MARK_FLAG_ENUM_CLASS(CppUtilities, IniFileParseOptions);
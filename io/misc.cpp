@@ -3,38 +3,426 @@
 #include "./misc.h"
 #include "./nativefilestream.h"
 
-#include <iterator>
+#include "../conversion/stringbuilder.h"
+
+#if defined(PLATFORM_UNIX)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#elif defined(PLATFORM_WINDOWS)
+#include "../conversion/stringconversion.h"
+#include <windows.h>
+#ifdef max
+#undef max // see explanation in stringconversion.cpp
+#endif
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <limits>
+#include <system_error>
 
 using namespace std;
 
 namespace CppUtilities {
 
-/*!
- * \brief Reads all contents of the specified file in a single call.
- * \throws Throws std::ios_base::failure when an error occurs or the specified \a maxSize
- *         would be exceeded.
- */
-std::string readFile(const std::string &path, std::string::size_type maxSize)
+/// \cond
+#ifdef PLATFORM_UNIX
+/// \brief Throws an std::ios_base::failure for the current errno.
+[[noreturn]] static void throwErrno(const char *message)
+{
+    throw std::ios_base::failure(message, std::error_code(errno, std::system_category()));
+}
+
+/// \brief Closes the file descriptor when going out of scope.
+struct FileDescriptorGuard {
+    ~FileDescriptorGuard()
+    {
+        if (descriptor != -1) {
+            ::close(descriptor);
+        }
+    }
+    void close()
+    {
+        if (::close(std::exchange(descriptor, -1)) == -1) {
+            throwErrno("close failed");
+        }
+    }
+    int descriptor;
+};
+
+/// \brief Reads the file via POSIX APIs into \a contents without going through a stream buffer.
+static void readFileViaDescriptor(const char *path, std::string &contents, std::string::size_type maxSize)
+{
+    const auto fd = FileDescriptorGuard{ ::open(path, O_RDONLY) };
+    if (fd.descriptor == -1) {
+        throwErrno("open failed");
+    }
+    struct stat fileInfo;
+    if (::fstat(fd.descriptor, &fileInfo) == -1) {
+        throwErrno("fstat failed");
+    }
+
+    // use the size reported by fstat() as hint; continue reading until EOF as the file might have grown and not all files report a size
+    const auto sizeHint = S_ISREG(fileInfo.st_mode) && fileInfo.st_size > 0 ? static_cast<std::string::size_type>(fileInfo.st_size) : 0;
+    if (maxSize != std::string::npos && sizeHint > maxSize) {
+        throw std::ios_base::failure("File exceeds max size");
+    }
+    auto bytesRead = std::string::size_type();
+    contents.resize(sizeHint ? sizeHint + 1 : 4096);
+    for (;;) {
+        if (bytesRead == contents.size()) {
+            contents.resize(contents.size() * 2);
+        }
+        const auto count = ::read(fd.descriptor, contents.data() + bytesRead, contents.size() - bytesRead);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throwErrno("read failed");
+        }
+        if (!count) {
+            break;
+        }
+        if ((bytesRead += static_cast<std::string::size_type>(count)) > maxSize && maxSize != std::string::npos) {
+            throw std::ios_base::failure("File exceeds max size");
+        }
+    }
+    contents.resize(bytesRead);
+}
+#else
+/// \brief Reads the file via NativeFileStream into \a contents using a single read() call on the stream.
+static void readFileViaStream(const std::string &path, std::string &contents, std::string::size_type maxSize)
 {
     auto file = NativeFileStream();
     file.exceptions(ios_base::failbit | ios_base::badbit);
     file.open(path, ios_base::in | ios_base::binary);
     file.seekg(0, ios_base::end);
-    string res;
     const auto size = static_cast<string::size_type>(file.tellg());
     if (maxSize != string::npos && size > maxSize) {
         throw ios_base::failure("File exceeds max size");
     }
-    res.reserve(size);
-    file.seekg(ios_base::beg);
-    // ignore warning about null pointer dereference from GCC 12 for now (which is *likely* not correct)
-#ifdef __GNUC__
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wnull-dereference"
+    file.seekg(0, ios_base::beg);
+    contents.resize(size);
+    file.read(contents.data(), static_cast<std::streamsize>(size));
+}
 #endif
-    res.assign((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
-#ifdef __GNUC__
-#pragma GCC diagnostic pop
+
+/// \brief Returns the path of a temporary file next to \a path for the specified \a attempt.
+static std::string makeTemporaryPath(std::string_view path, unsigned int attempt)
+{
+#ifdef PLATFORM_WINDOWS
+    const auto lastSeparator = path.find_last_of("/\\");
+    const auto processId = GetCurrentProcessId();
+#else
+    const auto lastSeparator = path.rfind('/');
+    const auto processId = ::getpid();
+#endif
+    const auto directorySize = lastSeparator == std::string_view::npos ? 0 : lastSeparator + 1;
+    return argsToString(path.substr(0, directorySize), '.', path.substr(directorySize), '.', processId, '.', attempt, ".tmp");
+}
+
+/// \brief Returns the directory of \a path or "." if \a path does not contain a directory.
+static std::string directoryOf(std::string_view path)
+{
+    const auto lastSlash = path.rfind('/');
+    return lastSlash == std::string_view::npos ? std::string(".") : std::string(path.substr(0, lastSlash ? lastSlash : 1));
+}
+
+/// \brief Counter to generate unique names for temporary files within the current process.
+static std::atomic<unsigned int> temporaryFileCounter;
+
+#if defined(PLATFORM_UNIX)
+/// \brief Writes all \a contents to \a fd.
+static void writeAll(int fd, std::string_view contents)
+{
+    for (auto *data = contents.data(), *const end = data + contents.size(); data != end;) {
+        const auto count = ::write(fd, data, static_cast<std::size_t>(end - data));
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throwErrno("write failed");
+        }
+        data += count;
+    }
+}
+
+/// \brief The mode new files are created with (before applying the umask) like fopen() does.
+constexpr auto newFileMode = S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH;
+
+/// \brief Returns the path of the file \a path points to if \a path is a symlink (following nested symlinks); otherwise returns \a path.
+/// \remarks Dangling symlinks are resolved as well so replacing the file creates the target of the symlink.
+static std::string resolveSymlinks(std::string path)
+{
+    struct stat fileInfo;
+    for (auto depth = 0; depth != 40 && ::lstat(path.data(), &fileInfo) == 0 && S_ISLNK(fileInfo.st_mode); ++depth) {
+        auto target = std::string(fileInfo.st_size > 0 ? static_cast<std::size_t>(fileInfo.st_size) + 1 : std::size_t(PATH_MAX), '\0');
+        const auto size = ::readlink(path.data(), target.data(), target.size());
+        if (size < 0) {
+            throwErrno("readlink failed");
+        }
+        target.resize(static_cast<std::size_t>(size));
+        if (const auto lastSlash = path.rfind('/'); (target.empty() || target.front() != '/') && lastSlash != std::string::npos) {
+            target.insert(0, path, 0, lastSlash + 1);
+        }
+        path = std::move(target);
+    }
+    return path;
+}
+
+/// \brief Writes \a contents to \a path in place.
+static void writeFileInPlace(const std::string &path, std::string_view contents, bool sync)
+{
+    auto fd = FileDescriptorGuard{ ::open(path.data(), O_WRONLY | O_CREAT | O_TRUNC, newFileMode) };
+    if (fd.descriptor == -1) {
+        throwErrno("open failed");
+    }
+    writeAll(fd.descriptor, contents);
+    if (sync && ::fsync(fd.descriptor) == -1) {
+        throwErrno("fsync failed");
+    }
+    fd.close();
+}
+
+/// \brief Returns whether fchown() failed with \a error because changing the owner is not permitted or not supported.
+static bool isChangingOwnerRefused(int error)
+{
+    return error == EPERM || error == EINVAL || error == ENOTSUP;
+}
+
+/// \brief Writes \a contents to a new temporary file next to \a path and returns the path of the temporary file.
+/// \remarks The owner and permissions of an existing file at \a path are taken over (the owner only as far as privileges allow).
+static std::string writeTemporaryFile(const std::string &path, std::string_view contents, bool sync)
+{
+    auto temporaryPath = std::string();
+    auto fd = FileDescriptorGuard{ -1 };
+    do {
+        temporaryPath = makeTemporaryPath(path, temporaryFileCounter++);
+        fd.descriptor = ::open(temporaryPath.data(), O_WRONLY | O_CREAT | O_EXCL, newFileMode);
+    } while (fd.descriptor == -1 && errno == EEXIST);
+    if (fd.descriptor == -1) {
+        throwErrno("open failed");
+    }
+    try {
+        struct stat fileInfo;
+        if (::stat(path.data(), &fileInfo) == 0) {
+            // change the owner first as doing so might clear the set-user-ID and set-group-ID bits; if not permitted, keep
+            // the current user as owner and try to take over at least the group
+            auto mode = fileInfo.st_mode & 07777;
+            if (::fchown(fd.descriptor, fileInfo.st_uid, fileInfo.st_gid) == -1) {
+                if (!isChangingOwnerRefused(errno)) {
+                    throwErrno("fchown failed");
+                }
+                if (::fchown(fd.descriptor, static_cast<uid_t>(-1), fileInfo.st_gid) == -1) {
+                    if (!isChangingOwnerRefused(errno)) {
+                        throwErrno("fchown failed");
+                    }
+                    // do not grant the permissions meant for the group of the file to the current user's group
+                    mode &= ~static_cast<mode_t>(S_ISGID | S_IRWXG);
+                }
+            }
+            if (::fchmod(fd.descriptor, mode) == -1) {
+                throwErrno("fchmod failed");
+            }
+        }
+        writeAll(fd.descriptor, contents);
+        if (sync && ::fsync(fd.descriptor) == -1) {
+            throwErrno("fsync failed");
+        }
+        fd.close();
+    } catch (...) {
+        ::unlink(temporaryPath.data());
+        throw;
+    }
+    return temporaryPath;
+}
+
+/// \brief Flushes the contents of the file at \a path to the storage device.
+/// \remarks Opens the file only for reading as it might already have the (read-only) permissions of the file it replaces.
+static void syncFile(const std::string &path)
+{
+    auto fd = FileDescriptorGuard{ ::open(path.data(), O_RDONLY) };
+    if (fd.descriptor == -1) {
+        throwErrno("open failed");
+    }
+    if (::fsync(fd.descriptor) == -1) {
+        throwErrno("fsync failed");
+    }
+    fd.close();
+}
+
+/// \brief Replaces the file at \a path with the file at \a temporaryPath; removes the temporary file on failure.
+static void replaceFile(const std::string &temporaryPath, const std::string &path, bool)
+{
+    if (::rename(temporaryPath.data(), path.data()) == -1) {
+        const auto error = errno;
+        ::unlink(temporaryPath.data());
+        throw std::ios_base::failure("rename failed", std::error_code(error, std::system_category()));
+    }
+}
+
+/// \brief Flushes the specified \a directory (and thus renames of files within it) to the storage device.
+static void syncDirectory(const std::string &directory)
+{
+    auto fd = FileDescriptorGuard{ ::open(directory.data(), O_RDONLY | O_DIRECTORY) };
+    if (fd.descriptor == -1) {
+        throwErrno("open directory failed");
+    }
+    if (::fsync(fd.descriptor) == -1) {
+        throwErrno("fsync directory failed");
+    }
+    fd.close();
+}
+
+/// \brief Removes the file at \a path ignoring any errors.
+static void removeFile(const std::string &path) noexcept
+{
+    ::unlink(path.data());
+}
+#elif defined(PLATFORM_WINDOWS)
+/// \brief Returns \a path as symlinks are not resolved under Windows.
+static std::string resolveSymlinks(std::string path)
+{
+    return path;
+}
+
+/// \brief Throws an std::ios_base::failure for the last error.
+[[noreturn]] static void throwLastError(const char *message)
+{
+    throw std::ios_base::failure(message, std::error_code(static_cast<int>(GetLastError()), std::system_category()));
+}
+
+/// \brief Converts the specified UTF-8 encoded \a path to UTF-16.
+static std::wstring makeWidePath(std::string_view path)
+{
+    auto ec = std::error_code();
+    auto widePath = convertMultiByteToWide(ec, path);
+    if (ec) {
+        throw std::ios_base::failure("converting path to UTF-16", ec);
+    }
+    return widePath;
+}
+
+/// \brief Closes the file handle when going out of scope.
+struct FileHandleGuard {
+    ~FileHandleGuard()
+    {
+        if (handle != INVALID_HANDLE_VALUE) {
+            CloseHandle(handle);
+        }
+    }
+    void close()
+    {
+        if (!CloseHandle(std::exchange(handle, INVALID_HANDLE_VALUE))) {
+            throwLastError("CloseHandle failed");
+        }
+    }
+    HANDLE handle;
+};
+
+/// \brief Writes all \a contents to \a handle and flushes it to the storage device if \a sync is set.
+static void writeAll(FileHandleGuard &file, std::string_view contents, bool sync)
+{
+    for (auto *data = contents.data(), *const end = data + contents.size(); data != end;) {
+        auto bytesWritten = DWORD();
+        const auto chunkSize = static_cast<DWORD>(std::min<std::size_t>(static_cast<std::size_t>(end - data), std::numeric_limits<DWORD>::max()));
+        if (!WriteFile(file.handle, data, chunkSize, &bytesWritten, nullptr)) {
+            throwLastError("WriteFile failed");
+        }
+        data += bytesWritten;
+    }
+    if (sync && !FlushFileBuffers(file.handle)) {
+        throwLastError("FlushFileBuffers failed");
+    }
+    file.close();
+}
+
+/// \brief Writes \a contents to \a path in place.
+static void writeFileInPlace(const std::string &path, std::string_view contents, bool sync)
+{
+    auto file = FileHandleGuard{ CreateFileW(makeWidePath(path).data(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr) };
+    if (file.handle == INVALID_HANDLE_VALUE) {
+        throwLastError("CreateFileW failed");
+    }
+    writeAll(file, contents, sync);
+}
+
+/// \brief Writes \a contents to a new temporary file next to \a path and returns the path of the temporary file.
+static std::string writeTemporaryFile(const std::string &path, std::string_view contents, bool sync)
+{
+    auto temporaryPath = std::string();
+    auto file = FileHandleGuard{ INVALID_HANDLE_VALUE };
+    do {
+        temporaryPath = makeTemporaryPath(path, temporaryFileCounter++);
+        file.handle = CreateFileW(makeWidePath(temporaryPath).data(), GENERIC_WRITE, 0, nullptr, CREATE_NEW, FILE_ATTRIBUTE_NORMAL, nullptr);
+    } while (file.handle == INVALID_HANDLE_VALUE && GetLastError() == ERROR_FILE_EXISTS);
+    if (file.handle == INVALID_HANDLE_VALUE) {
+        throwLastError("CreateFileW failed");
+    }
+    try {
+        writeAll(file, contents, sync);
+    } catch (...) {
+        DeleteFileW(makeWidePath(temporaryPath).data());
+        throw;
+    }
+    return temporaryPath;
+}
+
+/// \brief Flushes the contents of the file at \a path to the storage device.
+static void syncFile(const std::string &path)
+{
+    auto file = FileHandleGuard{ CreateFileW(makeWidePath(path).data(), GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+    if (file.handle == INVALID_HANDLE_VALUE) {
+        throwLastError("CreateFileW failed");
+    }
+    writeAll(file, std::string_view(), true);
+}
+
+/// \brief Replaces the file at \a path with the file at \a temporaryPath; removes the temporary file on failure.
+static void replaceFile(const std::string &temporaryPath, const std::string &path, bool sync)
+{
+    const auto wideTemporaryPath = makeWidePath(temporaryPath);
+    if (!MoveFileExW(wideTemporaryPath.data(), makeWidePath(path).data(), MOVEFILE_REPLACE_EXISTING | (sync ? MOVEFILE_WRITE_THROUGH : 0))) {
+        const auto error = GetLastError();
+        DeleteFileW(wideTemporaryPath.data());
+        throw std::ios_base::failure("MoveFileExW failed", std::error_code(static_cast<int>(error), std::system_category()));
+    }
+}
+
+/// \brief Does nothing as flushing directories is not supported under Windows.
+static void syncDirectory(const std::string &)
+{
+}
+
+/// \brief Removes the file at \a path ignoring any errors.
+static void removeFile(const std::string &path) noexcept
+{
+    try {
+        DeleteFileW(makeWidePath(path).data());
+    } catch (...) {
+    }
+}
+#endif
+/// \endcond
+
+/*!
+ * \brief Reads all contents of the specified file in a single call.
+ * \throws Throws std::ios_base::failure when an error occurs or the specified \a maxSize
+ *         would be exceeded.
+ * \remarks Under UNIX-like platforms the file is read via fstat() and read() bypassing any
+ *          stream buffer.
+ */
+std::string readFile(const std::string &path, std::string::size_type maxSize)
+{
+    auto res = std::string();
+#ifdef PLATFORM_UNIX
+    readFileViaDescriptor(path.data(), res, maxSize);
+#else
+    readFileViaStream(path, res, maxSize);
 #endif
     return res;
 }
@@ -49,19 +437,154 @@ std::string readFile(std::string_view path, std::string_view::size_type maxSize)
     return readFile(std::string(path), maxSize);
 }
 
+/*!
+ * \brief Reads all contents of the specified file into \a contents.
+ * \throws Throws std::ios_base::failure when an error occurs or the specified \a maxSize
+ *         would be exceeded.
+ * \remarks
+ * - Previous contents of \a contents are replaced. Its capacity is reused so reading many files into
+ *   the same buffer avoids allocations.
+ * - The contents of \a contents are unspecified if an exception is thrown.
+ */
+void readFile(std::string_view path, std::string &contents, std::string_view::size_type maxSize)
+{
+#ifdef PLATFORM_UNIX
+    if (path.size() < 256) {
+        char nullTerminatedPath[256];
+        std::copy(path.begin(), path.end(), nullTerminatedPath);
+        nullTerminatedPath[path.size()] = '\0';
+        readFileViaDescriptor(nullTerminatedPath, contents, maxSize);
+    } else {
+        readFileViaDescriptor(std::string(path).data(), contents, maxSize);
+    }
+#else
+    readFileViaStream(std::string(path), contents, maxSize);
+#endif
+}
+
 /*!
  * \brief Writes all \a contents to the specified file in a single call.
  * \throws Throws std::ios_base::failure when an error occurs.
- * \remarks Closing the file manually to prevent flushing the file within the d'tor which
- *          would suppress an exception
+ * \remarks The file is truncated and written in place. So a crash might leave a partially written file behind. Use
+ *          the overload taking WriteFileOptions to replace the file atomically instead.
  */
 void writeFile(std::string_view path, std::string_view contents)
 {
-    auto file = NativeFileStream();
-    file.exceptions(ios_base::failbit | ios_base::badbit);
-    file.open(std::string(path), ios_base::out | ios_base::trunc | ios_base::binary);
-    file.write(contents.data(), static_cast<std::streamoff>(contents.size()));
-    file.close();
+    writeFile(path, contents, WriteFileOptions::None);
+}
+
+/*!
+ * \brief Writes all \a contents to the specified file in a single call according to the specified \a options.
+ * \throws Throws std::ios_base::failure when an error occurs.
+ * \remarks
+ * - With WriteFileOptions::Atomic the file at \a path either has its previous contents or all of \a contents
+ *   at any point in time (if the file system supports atomic renames). Under UNIX-like platforms symlinks are followed
+ *   so the file they point to is replaced and the permissions and owner (as far as privileges allow) of an existing file
+ *   are preserved. Other metadata like extended attributes, ACLs and hard links is not preserved as the file is replaced
+ *   by a new file.
+ * - New files are created with permissions 0666 minus the umask (like fopen() does).
+ * - Whether the new contents survive a crash depends on WriteFileOptions::SyncFile and WriteFileOptions::SyncDirectory.
+ *   Use FileWriteBatch to write many files durably without paying for a directory flush per file.
+ */
+void writeFile(std::string_view path, std::string_view contents, WriteFileOptions options)
+{
+    auto nullTerminatedPath = std::string(path);
+    const auto sync = options && WriteFileOptions::SyncFile;
+    if (options && WriteFileOptions::Atomic) {
+        nullTerminatedPath = resolveSymlinks(std::move(nullTerminatedPath));
+        replaceFile(writeTemporaryFile(nullTerminatedPath, contents, sync), nullTerminatedPath, sync);
+    } else {
+        writeFileInPlace(nullTerminatedPath, contents, sync);
+    }
+    if (options && WriteFileOptions::SyncDirectory) {
+        syncDirectory(directoryOf(nullTerminatedPath));
+    }
+}
+
+/*!
+ * \class FileWriteBatch
+ * \brief The FileWriteBatch class allows replacing many files atomically while flushing each directory only once.
+ *
+ * Files passed to writeFile() are written to temporary files next to their target path. Calling commit() flushes all
+ * temporary files (if WriteFileOptions::SyncFile is set), renames them to their target paths and finally flushes each
+ * affected directory once (if WriteFileOptions::SyncDirectory is set). So the cost of flushing directories is paid once
+ * per directory and the flushes of the file contents are deferred so the file system can write them out together.
+ *
+ * Files which have not been committed are removed when the batch is destroyed or discard() is called. Each single file
+ * is replaced atomically; the batch as a whole is not atomic.
+ */
+
+/*!
+ * \brief Constructs a new batch. WriteFileOptions::Atomic is implied and need not be specified via \a options.
+ */
+FileWriteBatch::FileWriteBatch(WriteFileOptions options)
+    : m_options(options | WriteFileOptions::Atomic)
+{
+}
+
+/*!
+ * \brief Destroys the batch removing all files which have not been committed.
+ */
+FileWriteBatch::~FileWriteBatch()
+{
+    discard();
+}
+
+/*!
+ * \brief Writes all \a contents to a temporary file which replaces the file at \a path when commit() is called.
+ * \throws Throws std::ios_base::failure when an error occurs.
+ */
+void FileWriteBatch::writeFile(std::string_view path, std::string_view contents)
+{
+    auto nullTerminatedPath = resolveSymlinks(std::string(path));
+    auto temporaryPath = writeTemporaryFile(nullTerminatedPath, contents, false);
+    m_pendingFiles.emplace_back(std::move(temporaryPath), std::move(nullTerminatedPath));
+}
+
+/*!
+ * \brief Replaces all files written via writeFile() since the last commit.
+ * \throws Throws std::ios_base::failure when an error occurs. Files which have not been replaced yet remain pending
+ *         in this case and are removed when discard() is called or the batch is destroyed.
+ */
+void FileWriteBatch::commit()
+{
+    const auto sync = m_options && WriteFileOptions::SyncFile;
+    if (sync) {
+        for (const auto &[temporaryPath, path] : m_pendingFiles) {
+            syncFile(temporaryPath);
+        }
+    }
+    auto directories = std::vector<std::string>();
+    auto pendingFile = m_pendingFiles.begin();
+    try {
+        for (const auto end = m_pendingFiles.end(); pendingFile != end; ++pendingFile) {
+            replaceFile(pendingFile->first, pendingFile->second, sync);
+            if (m_options && WriteFileOptions::SyncDirectory) {
+                if (auto directory = directoryOf(pendingFile->second); std::find(directories.begin(), directories.end(), directory) == directories.end()) {
+                    directories.emplace_back(std::move(directory));
+                }
+            }
+        }
+    } catch (...) {
+        // the temporary file of the failing entry has already been removed by replaceFile()
+        m_pendingFiles.erase(m_pendingFiles.begin(), pendingFile + 1);
+        throw;
+    }
+    m_pendingFiles.clear();
+    for (const auto &directory : directories) {
+        syncDirectory(directory);
+    }
+}
+
+/*!
+ * \brief Removes all files written via writeFile() since the last commit without replacing their target files.
+ */
+void FileWriteBatch::discard()
+{
+    for (const auto &[temporaryPath, path] : m_pendingFiles) {
+        removeFile(temporaryPath);
+    }
+    m_pendingFiles.clear();
 }
 
 } // namespace CppUtilities
@@ -2,17 +2,62 @@
 #define IOUTILITIES_MISC_H
 
 #include "../global.h"
+#include "../misc/flagenumclass.h"
 
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 namespace CppUtilities {
 
+/*!
+ * \brief The WriteFileOptions enum specifies how writeFile() and FileWriteBatch write files.
+ */
+enum class WriteFileOptions {
+    None = 0, /**< the file is truncated and written in place */
+    Atomic = (1 << 0), /**< the contents are written to a temporary file in the same directory which then replaces the file; symlinks are
+                            followed and permissions/owner are taken over but e.g. extended attributes, ACLs and hard links are lost */
+    SyncFile = (1 << 1), /**< the file contents are flushed to the storage device (before replacing the file in atomic mode) */
+    SyncDirectory = (1 << 2), /**< the directory containing the file is flushed to the storage device (not supported under Windows) */
+    Durable = Atomic | SyncFile | SyncDirectory, /**< all of the above */
+};
+
 CPP_UTILITIES_EXPORT std::string readFile(const std::string &path, std::string::size_type maxSize = std::string::npos);
 #ifdef CPP_UTILITIES_IOMISC_STRING_VIEW
 CPP_UTILITIES_EXPORT std::string readFile(std::string_view path, std::string_view::size_type maxSize = std::string_view::npos);
 #endif
+CPP_UTILITIES_EXPORT void readFile(std::string_view path, std::string &contents, std::string_view::size_type maxSize = std::string_view::npos);
 CPP_UTILITIES_EXPORT void writeFile(std::string_view path, std::string_view contents);
+CPP_UTILITIES_EXPORT void writeFile(std::string_view path, std::string_view contents, WriteFileOptions options);
+
+class CPP_UTILITIES_EXPORT FileWriteBatch {
+public:
+    explicit FileWriteBatch(WriteFileOptions options = WriteFileOptions::Durable);
+    FileWriteBatch(const FileWriteBatch &) = delete;
+    FileWriteBatch &operator=(const FileWriteBatch &) = delete;
+    ~FileWriteBatch();
+
+    void writeFile(std::string_view path, std::string_view contents);
+    void commit();
+    void discard();
+    std::size_t pendingFileCount() const;
+
+private:
+    std::vector<std::pair<std::string, std::string>> m_pendingFiles;
+    WriteFileOptions m_options;
+};
+
+/*!
+ * \brief Returns the number of files written via writeFile() which have not been committed yet.
+ */
+inline std::size_t FileWriteBatch::pendingFileCount() const
+{
+    return m_pendingFiles.size();
+}
+
 } // namespace CppUtilities
 
+CPP_UTILITIES_MARK_FLAG_ENUM_CLASS(CppUtilities, CppUtilities::WriteFileOptions);
+
 #endif // IOUTILITIES_MISC_H
@@ -18,6 +18,8 @@ just "open failed: iostream error".
  * - It is possible to open a file from a native file descriptor. This is for instance useful when dealing with
  *   Android's `content://` URLs.
  * - Better error messages at least when opening a file, e.g. "Permission denied" instead of just "basic_ios::clear".
+ * - Scatter-gather IO via readScattered() and writeGathered() (and their positional variants) which transfers multiple
+ *   buffers with a single system call, bypassing the stream buffer.
  */
 
 #ifdef PLATFORM_WINDOWS
@@ -39,6 +41,8 @@ just "open failed: iostream error".
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
 #elif defined(PLATFORM_WINDOWS)
 #include <fcntl.h>
 #include <io.h>
@@ -50,6 +54,9 @@ just "open failed: iostream error".
 #endif
 #endif
 
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
 #endif
 
 using namespace std;
@@ -148,6 +155,144 @@ struct NativeFileParams {
 #endif
 };
 
+/// \cond
+#ifdef PLATFORM_UNIX
+/// \brief Returns the data pointer of the specified \a buffer as needed for struct iovec.
+static inline void *bufferData(const NativeFileStream::MutableBuffer &buffer)
+{
+    return buffer.data;
+}
+
+/// \brief Returns the data pointer of the specified \a buffer as needed for struct iovec.
+static inline void *bufferData(std::string_view buffer)
+{
+    return const_cast<char *>(buffer.data());
+}
+#elif defined(PLATFORM_WINDOWS)
+/// \brief Returns the data pointer of the specified \a buffer as needed for _read().
+static inline char *bufferData(const NativeFileStream::MutableBuffer &buffer)
+{
+    return buffer.data;
+}
+
+/// \brief Returns the data pointer of the specified \a buffer as needed for _write().
+static inline const char *bufferData(std::string_view buffer)
+{
+    return buffer.data();
+}
+#endif
+
+/// \brief Returns the size of the specified \a buffer.
+static inline std::size_t bufferSize(const NativeFileStream::MutableBuffer &buffer)
+{
+    return buffer.size;
+}
+
+/// \brief Returns the size of the specified \a buffer.
+static inline std::size_t bufferSize(std::string_view buffer)
+{
+    return buffer.size();
+}
+
+#ifdef PLATFORM_UNIX
+/*!
+ * \brief Transfers the specified \a buffers via readv()/writev() or preadv()/pwritev() if \a offset is not nullptr.
+ * \remarks
+ * - Buffers are passed in batches of a fixed size to stay within IOV_MAX without allocating.
+ * - Partial transfers are continued until all buffers are transferred or the end of the file is reached.
+ */
+template <typename BufferType, typename VectorFunction, typename PositionalVectorFunction>
+static std::size_t transferVectored(int descriptor, const BufferType *buffers, std::size_t bufferCount, std::uint64_t *offset,
+    VectorFunction vectorFunction, PositionalVectorFunction positionalVectorFunction, const char *errorMessage)
+{
+    constexpr auto batchSize = std::size_t(64);
+    auto total = std::size_t();
+    struct iovec vectors[batchSize];
+    for (auto batchStart = std::size_t(); batchStart < bufferCount; batchStart += batchSize) {
+        const auto batchCount = std::min(batchSize, bufferCount - batchStart);
+        for (auto i = std::size_t(); i != batchCount; ++i) {
+            vectors[i].iov_base = bufferData(buffers[batchStart + i]);
+            vectors[i].iov_len = bufferSize(buffers[batchStart + i]);
+        }
+        for (auto *current = vectors, *const end = vectors + batchCount;;) {
+            // skip buffers which have been transferred completely (or are empty)
+            for (; current != end && !current->iov_len; ++current)
+                ;
+            if (current == end) {
+                break;
+            }
+            const auto count = static_cast<int>(end - current);
+            const auto res = offset ? positionalVectorFunction(descriptor, current, count, static_cast<off_t>(*offset))
+                                    : vectorFunction(descriptor, current, count);
+            if (res < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::ios_base::failure(errorMessage, std::error_code(errno, std::system_category()));
+            }
+            if (!res) {
+                return total; // end of file reached
+            }
+            auto transferred = static_cast<std::size_t>(res);
+            total += transferred;
+            if (offset) {
+                *offset += transferred;
+            }
+            for (; current != end && transferred >= current->iov_len; transferred -= current->iov_len, ++current)
+                ;
+            if (current != end) {
+                current->iov_base = static_cast<char *>(current->iov_base) + transferred;
+                current->iov_len -= transferred;
+            }
+        }
+    }
+    return total;
+}
+#elif defined(PLATFORM_WINDOWS)
+/*!
+ * \brief Transfers the specified \a buffers one after another via \a transferFunction because Windows' CRT has no readv()/writev().
+ * \remarks If \a offset is not nullptr, the transfer happens at \a offset and the previous file position is restored afterwards.
+ */
+template <typename BufferType, typename TransferFunction>
+static std::size_t transferVectored(int descriptor, const BufferType *buffers, std::size_t bufferCount, std::uint64_t *offset,
+    TransferFunction transferFunction, const char *errorMessage)
+{
+    if (descriptor == -1) {
+        throw std::ios_base::failure(errorMessage, std::error_code(EBADF, std::system_category()));
+    }
+    auto previousPosition = __int64();
+    if (offset) {
+        if ((previousPosition = _lseeki64(descriptor, 0, SEEK_CUR)) == -1
+            || _lseeki64(descriptor, static_cast<__int64>(*offset), SEEK_SET) == -1) {
+            throw std::ios_base::failure(errorMessage, std::error_code(errno, std::system_category()));
+        }
+    }
+    auto total = std::size_t();
+    auto eof = false;
+    for (const auto *buffer = buffers, *const end = buffers + bufferCount; buffer != end && !eof; ++buffer) {
+        auto *data = bufferData(*buffer);
+        for (auto remaining = bufferSize(*buffer); remaining;) {
+            const auto chunkSize = static_cast<unsigned int>(std::min<std::size_t>(remaining, std::numeric_limits<int>::max()));
+            const auto res = transferFunction(descriptor, data, chunkSize);
+            if (res < 0) {
+                throw std::ios_base::failure(errorMessage, std::error_code(errno, std::system_category()));
+            }
+            if (!res) {
+                eof = true;
+                break;
+            }
+            data += res, remaining -= static_cast<std::size_t>(res), total += static_cast<std::size_t>(res);
+        }
+    }
+    if (offset) {
+        *offset += total;
+        _lseeki64(descriptor, previousPosition, SEEK_SET);
+    }
+    return total;
+}
+#endif
+/// \endcond
+
 /*!
  * \class NativeFileStream::FileBuffer
  * \brief The NativeFileStream::FileBuffer class holds an std::basic_streambuf<char> object obtained from a file path or a native file descriptor.
@@ -341,6 +486,96 @@ void NativeFileStream::setData(FileBuffer data, std::ios_base::openmode openMode
 #endif
 }
 
+/*!
+ * \brief Internally called before transferring data directly via the file descriptor.
+ *
+ * Flushes pending output of the stream buffer and discards its read-ahead so the position of the file descriptor
+ * matches the logical position of the stream and subsequent reads via the stream see data written directly.
+ */
+void NativeFileStream::syncDescriptor()
+{
+    auto *const buffer = rdbuf();
+    if (buffer->pubsync() == -1) {
+        throw std::ios_base::failure("flushing stream buffer failed");
+    }
+    const auto position = buffer->pubseekoff(0, ios_base::cur);
+    if (position != pos_type(off_type(-1))) {
+        buffer->pubseekpos(position);
+    }
+}
+
+/*!
+ * \brief Reads from the current position into the specified \a buffers using a single system call where possible (readv()).
+ * \returns Returns the number of bytes read which is only less than the total size of \a buffers if the end of the file has
+ *          been reached.
+ * \throws Throws std::ios_base::failure when an IO error occurs.
+ * \remarks
+ * - The data is read directly from the file descriptor. The stream buffer is synchronized before so mixing this function
+ *   with regular stream operations is fine.
+ * - The stream position is advanced by the number of bytes read.
+ */
+std::size_t NativeFileStream::readScattered(const MutableBuffer *buffers, std::size_t bufferCount)
+{
+    syncDescriptor();
+#ifdef PLATFORM_UNIX
+    return transferVectored(m_data.descriptor, buffers, bufferCount, nullptr, ::readv, ::preadv, "readv failed");
+#else
+    return transferVectored(m_data.descriptor, buffers, bufferCount, nullptr, ::_read, "_read failed");
+#endif
+}
+
+/*!
+ * \brief Reads from the specified \a offset into the specified \a buffers using a single system call where possible (preadv()).
+ * \returns Returns the number of bytes read which is only less than the total size of \a buffers if the end of the file has
+ *          been reached.
+ * \throws Throws std::ios_base::failure when an IO error occurs.
+ * \remarks The stream position is not altered.
+ */
+std::size_t NativeFileStream::readScatteredAt(std::uint64_t offset, const MutableBuffer *buffers, std::size_t bufferCount)
+{
+    syncDescriptor();
+#ifdef PLATFORM_UNIX
+    return transferVectored(m_data.descriptor, buffers, bufferCount, &offset, ::readv, ::preadv, "preadv failed");
+#else
+    return transferVectored(m_data.descriptor, buffers, bufferCount, &offset, ::_read, "_read failed");
+#endif
+}
+
+/*!
+ * \brief Writes the specified \a buffers at the current position using a single system call where possible (writev()).
+ * \returns Returns the number of bytes written which is always the total size of \a buffers.
+ * \throws Throws std::ios_base::failure when an IO error occurs.
+ * \remarks
+ * - The data is written directly to the file descriptor. The stream buffer is synchronized before so mixing this function
+ *   with regular stream operations is fine.
+ * - The stream position is advanced by the number of bytes written.
+ */
+std::size_t NativeFileStream::writeGathered(const std::string_view *buffers, std::size_t bufferCount)
+{
+    syncDescriptor();
+#ifdef PLATFORM_UNIX
+    return transferVectored(m_data.descriptor, buffers, bufferCount, nullptr, ::writev, ::pwritev, "writev failed");
+#else
+    return transferVectored(m_data.descriptor, buffers, bufferCount, nullptr, ::_write, "_write failed");
+#endif
+}
+
+/*!
+ * \brief Writes the specified \a buffers at the specified \a offset using a single system call where possible (pwritev()).
+ * \returns Returns the number of bytes written which is always the total size of \a buffers.
+ * \throws Throws std::ios_base::failure when an IO error occurs.
+ * \remarks The stream position is not altered. Do not use this function if the file has been opened in append mode.
+ */
+std::size_t NativeFileStream::writeGatheredAt(std::uint64_t offset, const std::string_view *buffers, std::size_t bufferCount)
+{
+    syncDescriptor();
+#ifdef PLATFORM_UNIX
+    return transferVectored(m_data.descriptor, buffers, bufferCount, &offset, ::writev, ::pwritev, "pwritev failed");
+#else
+    return transferVectored(m_data.descriptor, buffers, bufferCount, &offset, ::_write, "_write failed");
+#endif
+}
+
 #ifdef PLATFORM_WINDOWS
 /*!
  * \brief Converts the specified UTF-8 encoded \a path to UTF-16 for passing it to WinAPI functions.
@@ -4,13 +4,13 @@
 #include "../global.h"
 
 #ifdef CPP_UTILITIES_USE_NATIVE_FILE_BUFFER
+#include <cstdint>
+#include <initializer_list>
 #include <iostream>
 #include <memory>
 #include <streambuf>
 #include <string>
-#ifdef PLATFORM_WINDOWS
 #include <string_view>
-#endif
 #else
 #include <fstream>
 #endif
@@ -37,6 +37,12 @@ public:
         int descriptor = -1;
     };
 
+    /// \brief A buffer to read into via readScattered() and readScatteredAt().
+    struct MutableBuffer {
+        char *data = nullptr;
+        std::size_t size = 0;
+    };
+
     NativeFileStream();
     NativeFileStream(const char *path, std::ios_base::openmode openMode);
     NativeFileStream(const std::string &path, std::ios_base::openmode openMode);
@@ -57,9 +63,18 @@ public:
     static std::unique_ptr<wchar_t[]> makeWidePath(const char *path);
     static std::unique_ptr<wchar_t[]> makeWidePath(const std::string &path);
 #endif
+    std::size_t readScattered(const MutableBuffer *buffers, std::size_t bufferCount);
+    std::size_t readScattered(std::initializer_list<MutableBuffer> buffers);
+    std::size_t readScatteredAt(std::uint64_t offset, const MutableBuffer *buffers, std::size_t bufferCount);
+    std::size_t readScatteredAt(std::uint64_t offset, std::initializer_list<MutableBuffer> buffers);
+    std::size_t writeGathered(const std::string_view *buffers, std::size_t bufferCount);
+    std::size_t writeGathered(std::initializer_list<std::string_view> buffers);
+    std::size_t writeGatheredAt(std::uint64_t offset, const std::string_view *buffers, std::size_t bufferCount);
+    std::size_t writeGatheredAt(std::uint64_t offset, std::initializer_list<std::string_view> buffers);
 
 private:
     void setData(FileBuffer data, std::ios_base::openmode openMode);
+    void syncDescriptor();
 
     FileBuffer m_data;
     std::ios_base::openmode m_openMode;
@@ -129,6 +144,42 @@ inline bool NativeFileStream::is_open() const
     return isOpen();
 }
 
+/*!
+ * \brief Reads from the current position into the specified \a buffers.
+ * \sa See the overload taking a pointer and a count for details.
+ */
+inline std::size_t NativeFileStream::readScattered(std::initializer_list<MutableBuffer> buffers)
+{
+    return readScattered(buffers.begin(), buffers.size());
+}
+
+/*!
+ * \brief Reads from the specified \a offset into the specified \a buffers.
+ * \sa See the overload taking a pointer and a count for details.
+ */
+inline std::size_t NativeFileStream::readScatteredAt(std::uint64_t offset, std::initializer_list<MutableBuffer> buffers)
+{
+    return readScatteredAt(offset, buffers.begin(), buffers.size());
+}
+
+/*!
+ * \brief Writes the specified \a buffers at the current position.
+ * \sa See the overload taking a pointer and a count for details.
+ */
+inline std::size_t NativeFileStream::writeGathered(std::initializer_list<std::string_view> buffers)
+{
+    return writeGathered(buffers.begin(), buffers.size());
+}
+
+/*!
+ * \brief Writes the specified \a buffers at the specified \a offset.
+ * \sa See the overload taking a pointer and a count for details.
+ */
+inline std::size_t NativeFileStream::writeGatheredAt(std::uint64_t offset, std::initializer_list<std::string_view> buffers)
+{
+    return writeGatheredAt(offset, buffers.begin(), buffers.size());
+}
+
 #else // CPP_UTILITIES_USE_NATIVE_FILE_BUFFER
 
 using NativeFileStream = std::fstream;
@@ -2,9 +2,16 @@
 
 #include "./path.h"
 
+#include <algorithm>
+#include <array>
 #include <cstdlib>
+#include <cstring>
 #include <string>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 using namespace std;
 
 namespace CppUtilities {
@@ -65,22 +72,234 @@ std::string_view directory(std::string_view path)
     return path.substr(0, lastSeparator + 1);
 }
 
+/// \cond
+static constexpr char invalidFileNameChars[] = { '\"', '<', '>', '?', '!', '*', '|', '/', ':', '\\', '\n' };
+
+/*!
+ * \brief Returns a table telling for each byte whether it is considered an invalid file name character.
+ */
+static constexpr std::array<bool, 256> makeInvalidFileNameCharTable()
+{
+    auto table = std::array<bool, 256>();
+    for (const auto c : invalidFileNameChars) {
+        table[static_cast<unsigned char>(c)] = true;
+    }
+    return table;
+}
+
+static constexpr auto invalidFileNameCharTable = makeInvalidFileNameCharTable();
+
+#ifdef __SSE2__
+/*!
+ * \brief Returns a mask with the n-th bit set if the n-th of the 16 bytes at \a data is an invalid file name character.
+ */
+static unsigned int invalidFileNameCharMask(const char *data)
+{
+    const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+    auto matches = _mm_setzero_si128();
+    for (const auto c : invalidFileNameChars) {
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, _mm_set1_epi8(c)));
+    }
+    return static_cast<unsigned int>(_mm_movemask_epi8(matches));
+}
+
+/*!
+ * \brief Returns the number of bits set in the specified 16-bit \a mask.
+ */
+static unsigned int countBits(unsigned int mask)
+{
+    mask = mask - ((mask >> 1) & 0x5555u);
+    mask = (mask & 0x3333u) + ((mask >> 2) & 0x3333u);
+    mask = (mask + (mask >> 4)) & 0x0F0Fu;
+    return (mask + (mask >> 8)) & 0x1Fu;
+}
+
+/*!
+ * \brief Copies the valid file name characters of the 16 bytes at \a begin to \a out.
+ * \remarks Blocks without invalid characters (the common case) are copied as a whole or not touched at all as long as
+ *          nothing has been removed so far.
+ */
+static char *copyValidFileNameBlock(const char *begin, unsigned int invalidMask, char *out)
+{
+    if (!invalidMask) {
+        if (out != begin) {
+            std::memmove(out, begin, 16);
+        }
+        return out + 16;
+    }
+    for (auto i = 0u; i != 16u; ++i) {
+        *out = begin[i];
+        out += !((invalidMask >> i) & 1u);
+    }
+    return out;
+}
+#endif
+
+/*!
+ * \brief Copies the valid file name characters within [\a begin, \a end) to \a out.
+ * \returns Returns the end of the copied characters.
+ * \remarks
+ * - \a out may be equal to \a begin or point before it (in-place compaction).
+ * - Characters are written unconditionally but \a out is only advanced for valid ones to avoid a branch per character.
+ * - If SSE2 is available, blocks of 16 bytes are classified at once.
+ */
+static char *copyValidFileNameChars(const char *begin, const char *end, char *out)
+{
+#ifdef __SSE2__
+    for (; end - begin >= 16; begin += 16) {
+        out = copyValidFileNameBlock(begin, invalidFileNameCharMask(begin), out);
+    }
+#endif
+    for (; begin != end; ++begin) {
+        *out = *begin;
+        out += !invalidFileNameCharTable[static_cast<unsigned char>(*begin)];
+    }
+    return out;
+}
+/// \endcond
+
 /*!
  * \brief Removes invalid characters from the specified \a fileName.
  *
- * The characters <, >, ?, !, *, |, /, :, \ and new lines are considered as invalid.
+ * The characters ", <, >, ?, !, *, |, /, :, \ and new lines are considered as invalid.
+ *
+ * \remarks The characters are removed in a single pass in-place so \a fileName is never reallocated. If SSE2 is available,
+ *          16 characters are classified at once.
  */
 void removeInvalidChars(std::string &fileName)
 {
-    size_t startPos = 0;
-    static const char invalidPathChars[] = { '\"', '<', '>', '?', '!', '*', '|', '/', ':', '\\', '\n' };
-    for (const char *i = invalidPathChars, *end = invalidPathChars + sizeof(invalidPathChars); i != end; ++i) {
-        startPos = fileName.find(*i);
-        while (startPos != string::npos) {
-            fileName.replace(startPos, 1, string());
-            startPos = fileName.find(*i, startPos);
+    const auto data = fileName.data();
+    fileName.resize(static_cast<std::size_t>(copyValidFileNameChars(data, data + fileName.size(), data) - data));
+}
+
+/*!
+ * \brief Removes invalid characters from many file names stored contiguously in \a fileNames.
+ *
+ * The i-th file name is expected to end at the offset \a fileNameEnds[i] within \a fileNames and to start where the
+ * previous one ends (or at the beginning of \a fileNames). So the offsets must be ascending and not exceed the size of
+ * \a fileNames. After the call \a fileNames only contains the sanitized names and \a fileNameEnds is updated
+ * accordingly. Data following the last file name is discarded.
+ *
+ * The same characters are considered invalid as by removeInvalidChars(std::string &). All names are processed in a
+ * single pass in-place so this is considerably faster than sanitizing many individual strings.
+ */
+void removeInvalidChars(std::string &fileNames, std::vector<std::size_t> &fileNameEnds)
+{
+    const auto data = fileNames.data();
+    const auto end = data + (fileNameEnds.empty() ? std::size_t() : fileNameEnds.back());
+    auto begin = static_cast<const char *>(data);
+    auto out = data;
+    auto fileNameEnd = fileNameEnds.begin();
+    const auto fileNameEndsEnd = fileNameEnds.end();
+#ifdef __SSE2__
+    // process all names as one buffer; the new end of a name within a block is determined via the mask of the block
+    for (; end - begin >= 16; begin += 16) {
+        const auto invalidMask = invalidFileNameCharMask(begin);
+        const auto blockOffset = static_cast<std::size_t>(begin - data);
+        for (; fileNameEnd != fileNameEndsEnd && *fileNameEnd < blockOffset + 16; ++fileNameEnd) {
+            const auto charsBeforeEnd = static_cast<unsigned int>(*fileNameEnd - blockOffset);
+            *fileNameEnd = static_cast<std::size_t>(out - data) + charsBeforeEnd - countBits(invalidMask & ((1u << charsBeforeEnd) - 1u));
+        }
+        out = copyValidFileNameBlock(begin, invalidMask, out);
+    }
+#endif
+    for (; begin != end; ++begin) {
+        for (const auto offset = static_cast<std::size_t>(begin - data); fileNameEnd != fileNameEndsEnd && *fileNameEnd == offset; ++fileNameEnd) {
+            *fileNameEnd = static_cast<std::size_t>(out - data);
+        }
+        *out = *begin;
+        out += !invalidFileNameCharTable[static_cast<unsigned char>(*begin)];
+    }
+    for (; fileNameEnd != fileNameEndsEnd; ++fileNameEnd) {
+        *fileNameEnd = static_cast<std::size_t>(out - data);
+    }
+    fileNames.resize(static_cast<std::size_t>(out - data));
+}
+
+/// \cond
+/*!
+ * \brief Returns the start of the last component within the normalized \a path (of the specified \a size).
+ */
+static std::size_t lastComponentStart(const char *path, std::size_t size, std::size_t base)
+{
+    for (auto i = size; i > base; --i) {
+        if (path[i - 1] == '/') {
+            return i;
+        }
+    }
+    return base;
+}
+/// \endcond
+
+/*!
+ * \brief Normalizes the specified \a path lexically and writes the result to \a buffer.
+ * \returns Returns a view of the normalized path within \a buffer.
+ * \remarks
+ * - The normalization follows the rules of std::filesystem::path::lexically_normal(): Duplicate separators are
+ *   collapsed, "." components are removed, "<component>/.." is removed, ".." directly after the root is removed
+ *   and an empty result becomes ".". A trailing separator is preserved (except after "..").
+ * - Slashes and backslashes are both considered separators. The normalized path always uses slashes (as paths
+ *   within archives do). Windows root names like "C:" are treated like any other component and a leading "//" is treated like "/".
+ * - The file system is not accessed, so symlinks are not taken into account.
+ * - The normalized path is never longer than \a path so \a buffer must provide at least path.size() bytes. It may
+ *   point to path.data() to normalize in-place.
+ */
+std::string_view normalizePath(std::string_view path, char *buffer)
+{
+    if (path.empty()) {
+        return std::string_view();
+    }
+    const auto isAbsolute = PathComponentIterator::isSeparator(path.front());
+    const auto base = isAbsolute ? std::size_t(1) : std::size_t(0);
+    auto size = base;
+    auto endsWithDirectory = false;
+    if (isAbsolute) {
+        buffer[0] = '/';
+    }
+    for (const auto component : PathComponents(path)) {
+        if (component == ".") {
+            endsWithDirectory = true;
+            continue;
         }
+        if (component == "..") {
+            const auto lastStart = lastComponentStart(buffer, size, base);
+            if (size > base && std::string_view(buffer + lastStart, size - lastStart) != "..") {
+                // remove the last component (and the separator in front of it)
+                size = lastStart > base ? lastStart - 1 : base;
+                endsWithDirectory = true;
+                continue;
+            }
+            if (isAbsolute) {
+                // remove ".." directly after the root
+                endsWithDirectory = true;
+                continue;
+            }
+        }
+        if (size > base) {
+            buffer[size++] = '/';
+        }
+        std::memmove(buffer + size, component.data(), component.size());
+        size += component.size();
+        endsWithDirectory = false;
     }
+    if (size > base && (endsWithDirectory || PathComponentIterator::isSeparator(path.back()))) {
+        const auto lastStart = lastComponentStart(buffer, size, base);
+        if (std::string_view(buffer + lastStart, size - lastStart) != "..") {
+            buffer[size++] = '/';
+        }
+    } else if (!size) {
+        buffer[size++] = '.';
+    }
+    return std::string_view(buffer, size);
+}
+
+/*!
+ * \brief Normalizes the specified \a path lexically in-place.
+ * \sa See normalizePath(std::string_view, char *) for details.
+ */
+void normalizePath(std::string &path)
+{
+    path.resize(normalizePath(path, path.data()).size());
 }
 
 } // namespace CppUtilities
@@ -7,8 +7,11 @@
 #include "../conversion/stringconversion.h"
 #endif
 
+#include <cstddef>
+#include <iterator>
 #include <string>
 #include <string_view>
+#include <vector>
 #ifdef CPP_UTILITIES_USE_STANDARD_FILESYSTEM
 #include <filesystem>
 #endif
@@ -34,6 +37,174 @@ CPP_UTILITIES_EXPORT std::string_view fileName(std::string_view path);
 CPP_UTILITIES_EXPORT std::string_view directory(std::string_view path);
 #endif
 CPP_UTILITIES_EXPORT void removeInvalidChars(std::string &fileName);
+CPP_UTILITIES_EXPORT void removeInvalidChars(std::string &fileNames, std::vector<std::size_t> &fileNameEnds);
+CPP_UTILITIES_EXPORT std::string_view normalizePath(std::string_view path, char *buffer);
+CPP_UTILITIES_EXPORT void normalizePath(std::string &path);
+
+/*!
+ * \brief The PathComponentIterator class iterates over the components of a path without allocating.
+ * \remarks
+ * - Slashes and backslashes are both considered separators (like fileName() and directory() do).
+ * - Empty components (caused by leading, trailing or duplicate separators) are skipped.
+ * - "." and ".." are returned as-is; use normalizePath() to resolve them.
+ * \sa PathComponents
+ */
+class CPP_UTILITIES_EXPORT PathComponentIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::string_view *;
+    using reference = const std::string_view &;
+
+    explicit PathComponentIterator(std::string_view path = std::string_view());
+
+    reference operator*() const;
+    pointer operator->() const;
+    PathComponentIterator &operator++();
+    PathComponentIterator operator++(int);
+    bool operator==(const PathComponentIterator &other) const;
+    bool operator!=(const PathComponentIterator &other) const;
+
+    static bool isSeparator(char c);
+
+private:
+    void findComponent(const char *begin);
+
+    const char *m_end;
+    std::string_view m_component;
+};
+
+/*!
+ * \brief Constructs an iterator pointing to the first component of \a path.
+ * \remarks The default-constructed iterator is the end-iterator.
+ */
+inline PathComponentIterator::PathComponentIterator(std::string_view path)
+    : m_end(path.data() + path.size())
+{
+    findComponent(path.data());
+}
+
+/*!
+ * \brief Returns the current component.
+ */
+inline PathComponentIterator::reference PathComponentIterator::operator*() const
+{
+    return m_component;
+}
+
+/*!
+ * \brief Returns a pointer to the current component.
+ */
+inline PathComponentIterator::pointer PathComponentIterator::operator->() const
+{
+    return &m_component;
+}
+
+/*!
+ * \brief Advances to the next component.
+ */
+inline PathComponentIterator &PathComponentIterator::operator++()
+{
+    findComponent(m_component.data() + m_component.size());
+    return *this;
+}
+
+/*!
+ * \brief Advances to the next component returning the previous state.
+ */
+inline PathComponentIterator PathComponentIterator::operator++(int)
+{
+    auto previous = *this;
+    ++*this;
+    return previous;
+}
+
+/*!
+ * \brief Returns whether the iterator points to the same component as \a other.
+ */
+inline bool PathComponentIterator::operator==(const PathComponentIterator &other) const
+{
+    return m_component.data() == other.m_component.data() && m_component.size() == other.m_component.size();
+}
+
+/*!
+ * \brief Returns whether the iterator points to a different component than \a other.
+ */
+inline bool PathComponentIterator::operator!=(const PathComponentIterator &other) const
+{
+    return !(*this == other);
+}
+
+/*!
+ * \brief Returns whether \a c is considered a path separator.
+ */
+inline bool PathComponentIterator::isSeparator(char c)
+{
+    return c == '/' || c == '\\';
+}
+
+/// \cond
+inline void PathComponentIterator::findComponent(const char *begin)
+{
+    for (; begin != m_end && isSeparator(*begin); ++begin)
+        ;
+    if (begin == m_end) {
+        m_component = std::string_view();
+        return;
+    }
+    auto end = begin + 1;
+    for (; end != m_end && !isSeparator(*end); ++end)
+        ;
+    m_component = std::string_view(begin, static_cast<std::size_t>(end - begin));
+}
+/// \endcond
+
+/*!
+ * \brief The PathComponents class allows iterating over the components of a path using a range-based for loop.
+ * \remarks The components are views into the specified path so it must outlive the iteration.
+ *
+ * Example:
+ * ```
+ * for (const auto component : PathComponents("/usr//lib/libc++utilities.so")) {
+ *     // component is "usr", then "lib", then "libc++utilities.so"
+ * }
+ * ```
+ */
+class CPP_UTILITIES_EXPORT PathComponents {
+public:
+    explicit PathComponents(std::string_view path);
+
+    PathComponentIterator begin() const;
+    PathComponentIterator end() const;
+
+private:
+    std::string_view m_path;
+};
+
+/*!
+ * \brief Constructs a new range for the components of the specified \a path.
+ */
+inline PathComponents::PathComponents(std::string_view path)
+    : m_path(path)
+{
+}
+
+/*!
+ * \brief Returns an iterator pointing to the first component.
+ */
+inline PathComponentIterator PathComponents::begin() const
+{
+    return PathComponentIterator(m_path);
+}
+
+/*!
+ * \brief Returns an iterator pointing past the last component.
+ */
+inline PathComponentIterator PathComponents::end() const
+{
+    return PathComponentIterator();
+}
 
 /// \brief The native type used by std::filesystem:path.
 /// \remarks The current implementation requires this to be always wchar_t on Windows and char otherwise.
@@ -88,7 +259,6 @@ inline
 #endif
 }
 
-#if !defined(CPP_UTILITIES_NO_ICONV) || !defined(PLATFORM_WINDOWS)
 /*!
  * \brief Returns \a path as UTF-8 string or string view.
  * \sa This is the opposite of makeNativePath() so check out remarks of that function for details.
@@ -108,7 +278,6 @@ inline
     return path;
 #endif
 }
-#endif
 
 } // namespace CppUtilities
 
@@ -10,7 +10,6 @@
 
 #include <algorithm>
 #include <array>
-#include <cctype>
 #include <string>
 #include <string_view>
 
@@ -31,24 +30,22 @@ inline std::string getOpenSslError()
 }
 
 /// \brief Extracts the base64-encoded body from a PEM block.
-/// \remarks This function is an implementation detail and must not be called by users of this library.
-inline std::string extractPemBody(std::string_view pem, std::string_view header)
+/// \remarks
+/// - The body is returned as-is (including line breaks); it is supposed to be decoded with Base64DecodeOptions::SkipWhitespace.
+/// - This function is an implementation detail and must not be called by users of this library.
+inline std::string_view extractPemBody(std::string_view pem, std::string_view header)
 {
-    auto body = std::string();
     auto begin = pem.find(header);
     if (begin == std::string_view::npos) {
-        return body;
+        return std::string_view();
     }
     begin += header.size();
 
     auto end = pem.find("-----END", begin);
     if (end == std::string_view::npos) {
-        return body;
+        return std::string_view();
     }
-
-    body = std::string(pem.data() + begin, end - begin);
-    body.erase(std::remove_if(body.begin(), body.end(), ::isspace), body.end());
-    return body;
+    return pem.substr(begin, end - begin);
 }
 
 /// \brief Converts a PEM-encoded signature into a DER-encoded signature.
@@ -56,15 +53,17 @@ inline std::string extractPemBody(std::string_view pem, std::string_view header)
 inline std::string parsePemSignature(std::string_view pemSignature, std::pair<std::unique_ptr<std::uint8_t[]>, std::uint32_t> &decodedSignature)
 {
     const auto pemSignatureBody = extractPemBody(pemSignature, "-----BEGIN SIGNATURE-----");
-    if (pemSignatureBody.empty()) {
-        return "invalid or missing PEM signature block";
-    }
     try {
-        decodedSignature = decodeBase64(pemSignatureBody.data(), static_cast<std::uint32_t>(pemSignatureBody.size()));
-        return std::string();
+        decodedSignature.first = std::make_unique<std::uint8_t[]>(Base64Decoder::maxOutputSize(pemSignatureBody.size()));
+        decodedSignature.second = static_cast<std::uint32_t>(
+            decodeBase64(pemSignatureBody.data(), pemSignatureBody.size(), decodedSignature.first.get(), Base64DecodeOptions::SkipWhitespace));
     } catch (const ConversionException &e) {
         return "unable to decode PEM signature block";
     }
+    if (!decodedSignature.second) {
+        return "invalid or missing PEM signature block";
+    }
+    return std::string();
 }
 
 } // namespace Detail
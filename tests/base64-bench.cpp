@@ -0,0 +1,178 @@
+#include "../chrono/datetime.h"
+#include "../conversion/conversionexception.h"
+#include "../conversion/stringconversion.h"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace CppUtilities;
+
+const char *const base64Chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+const char base64Pad = '=';
+
+/*!
+ * \brief Encodes \a data like encodeBase64() did before it has been made table-driven.
+ */
+static string legacyEncodeBase64(const std::uint8_t *data, std::uint32_t dataSize)
+{
+    auto encoded = std::string();
+    auto mod = static_cast<std::uint8_t>(dataSize % 3);
+    auto temp = std::uint32_t();
+    encoded.reserve(((dataSize / 3) + (mod > 0)) * 4);
+    for (const std::uint8_t *end = --data + dataSize - mod; data != end;) {
+        temp = static_cast<std::uint32_t>(*++data << 16);
+        temp |= static_cast<std::uint32_t>(*++data << 8);
+        temp |= *++data;
+        encoded.push_back(base64Chars[(temp & 0x00FC0000) >> 18]);
+        encoded.push_back(base64Chars[(temp & 0x0003F000) >> 12]);
+        encoded.push_back(base64Chars[(temp & 0x00000FC0) >> 6]);
+        encoded.push_back(base64Chars[(temp & 0x0000003F)]);
+    }
+    switch (mod) {
+    case 1:
+        temp = static_cast<std::uint32_t>(*++data << 16);
+        encoded.push_back(base64Chars[(temp & 0x00FC0000) >> 18]);
+        encoded.push_back(base64Chars[(temp & 0x0003F000) >> 12]);
+        encoded.push_back(base64Pad);
+        encoded.push_back(base64Pad);
+        break;
+    case 2:
+        temp = static_cast<std::uint32_t>(*++data << 16);
+        temp |= static_cast<std::uint32_t>(*++data << 8);
+        encoded.push_back(base64Chars[(temp & 0x00FC0000) >> 18]);
+        encoded.push_back(base64Chars[(temp & 0x0003F000) >> 12]);
+        encoded.push_back(base64Chars[(temp & 0x00000FC0) >> 6]);
+        encoded.push_back(base64Pad);
+        break;
+    }
+    return encoded;
+}
+
+/*!
+ * \brief Decodes \a encodedStr like decodeBase64() did before it has been made table-driven.
+ */
+static std::pair<std::unique_ptr<std::uint8_t[]>, std::uint32_t> legacyDecodeBase64(const char *encodedStr, const std::uint32_t strSize)
+{
+    if (!strSize) {
+        return std::make_pair(std::make_unique<std::uint8_t[]>(0), 0); // early return to prevent clazy warning
+    }
+    if (strSize % 4) {
+        throw ConversionException("invalid size of base64");
+    }
+    std::uint32_t decodedSize = (strSize / 4) * 3;
+    const char *const end = encodedStr + strSize;
+    if (*(end - 1) == base64Pad) {
+        --decodedSize;
+    }
+    if (*(end - 2) == base64Pad) {
+        --decodedSize;
+    }
+    auto buffer = std::make_unique<std::uint8_t[]>(decodedSize);
+    auto *iter = buffer.get() - 1;
+    while (encodedStr < end) {
+        std::int32_t temp = 0;
+        for (std::uint8_t quantumPos = 0; quantumPos < 4; ++quantumPos, ++encodedStr) {
+            temp <<= 6;
+            if (*encodedStr >= 'A' && *encodedStr <= 'Z') {
+                temp |= *encodedStr - 'A';
+            } else if (*encodedStr >= 'a' && *encodedStr <= 'z') {
+                temp |= *encodedStr - 'a' + 26;
+            } else if (*encodedStr >= '0' && *encodedStr <= '9') {
+                temp |= *encodedStr - '0' + 2 * 26;
+            } else if (*encodedStr == '+') {
+                temp |= 2 * 26 + 10;
+            } else if (*encodedStr == '/') {
+                temp |= 2 * 26 + 10 + 1;
+            } else if (*encodedStr == base64Pad) {
+                switch (end - encodedStr) {
+                case 1:
+                    *++iter = static_cast<std::uint8_t>((temp >> 16) & 0xFF);
+                    *++iter = static_cast<std::uint8_t>((temp >> 8) & 0xFF);
+                    return std::make_pair(std::move(buffer), decodedSize);
+                case 2:
+                    *++iter = static_cast<std::uint8_t>((temp >> 10) & 0xFF);
+                    return std::make_pair(std::move(buffer), decodedSize);
+                default:
+                    throw ConversionException("invalid padding in base64");
+                }
+            } else {
+                throw ConversionException("invalid character in base64");
+            }
+        }
+        *++iter = static_cast<std::uint8_t>((temp >> 16) & 0xFF);
+        *++iter = static_cast<std::uint8_t>((temp >> 8) & 0xFF);
+        *++iter = static_cast<std::uint8_t>(temp & 0xFF);
+    }
+    return std::make_pair(std::move(buffer), decodedSize);
+}
+
+int main()
+{
+    cout << "Benchmarking table-driven Base64 encoding/decoding vs. previous implementation" << endl;
+
+    // simulate embedded cover art and PEM signatures; a few large buffers and many small ones
+    auto randomEngine = std::minstd_rand();
+    auto buffers = vector<vector<std::uint8_t>>();
+    for (auto i = 0u; i != 20000u; ++i) {
+        auto &buffer = buffers.emplace_back(i % 100 ? 96u + i % 64u : 256u * 1024u);
+        for (auto &byte : buffer) {
+            byte = static_cast<std::uint8_t>(randomEngine());
+        }
+    }
+    auto encodedBuffers = vector<string>();
+    for (const auto &buffer : buffers) {
+        encodedBuffers.emplace_back(legacyEncodeBase64(buffer.data(), static_cast<std::uint32_t>(buffer.size())));
+    }
+
+    auto t1 = DateTime::exactGmtNow();
+    auto size1 = size_t();
+    for (const auto &buffer : buffers) {
+        size1 += legacyEncodeBase64(buffer.data(), static_cast<std::uint32_t>(buffer.size())).size();
+    }
+    for (const auto &encoded : encodedBuffers) {
+        size1 += legacyDecodeBase64(encoded.data(), static_cast<std::uint32_t>(encoded.size())).second;
+    }
+    auto t2 = DateTime::exactGmtNow();
+    const auto diff1 = t2 - t1;
+    cout << "previous implementation: " << diff1.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto size2 = size_t();
+    for (const auto &buffer : buffers) {
+        size2 += encodeBase64(buffer.data(), static_cast<std::uint32_t>(buffer.size())).size();
+    }
+    for (const auto &encoded : encodedBuffers) {
+        size2 += decodeBase64(encoded.data(), static_cast<std::uint32_t>(encoded.size())).second;
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diff2 = t2 - t1;
+    cout << "encodeBase64()/decodeBase64(): " << diff2.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto size3 = size_t();
+    auto encodeBuffer = string();
+    auto decodeBuffer = vector<std::uint8_t>();
+    for (const auto &buffer : buffers) {
+        encodeBuffer.resize(Base64Encoder::maxOutputSize(buffer.size()));
+        size3 += encodeBase64(buffer.data(), buffer.size(), encodeBuffer.data());
+    }
+    for (const auto &encoded : encodedBuffers) {
+        decodeBuffer.resize(Base64Decoder::maxOutputSize(encoded.size()));
+        size3 += decodeBase64(encoded.data(), encoded.size(), decodeBuffer.data());
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diff3 = t2 - t1;
+    cout << "encodeBase64()/decodeBase64() with reused buffer: " << diff3.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    cout << "total size (should be equal): " << size1 << ", " << size2 << ", " << size3 << endl;
+    cout << "factor (previous / table-driven): " << (static_cast<double>(diff1.totalTicks()) / static_cast<double>(diff2.totalTicks())) << endl;
+    cout << "factor (previous / table-driven with reused buffer): "
+         << (static_cast<double>(diff1.totalTicks()) / static_cast<double>(diff3.totalTicks())) << endl;
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include "../chrono/datetime.h"
+#include "../io/buffersearch.h"
+
+#include <iostream>
+#include <string>
+#include <string_view>
+
+using namespace std;
+using namespace CppUtilities;
+
+/*!
+ * \brief Searches \a buffer like BufferSearch::process() did before the std::memchr() fast path has been added.
+ */
+static const char *processCharByChar(string_view searchTerm, string_view terminationChars, string_view buffer, string &result)
+{
+    auto searchTermIterator = searchTerm.begin();
+    for (auto i = buffer.begin(), end = buffer.end(); i != end; ++i) {
+        const auto currentChar = *i;
+        if (searchTermIterator == searchTerm.end()) {
+            if (terminationChars.find(currentChar) != string_view::npos) {
+                return &*i;
+            }
+            result += currentChar;
+            continue;
+        }
+        searchTermIterator = currentChar == *searchTermIterator ? searchTermIterator + 1 : searchTerm.begin();
+    }
+    return nullptr;
+}
+
+int main()
+{
+    cout << "Benchmarking BufferSearch vs. searching char by char" << endl;
+
+    // simulate log output which contains the search term only at the very end
+    constexpr auto chunkSize = 4u * 1024u * 1024u;
+    constexpr auto chunkCount = 64u;
+    constexpr auto iterations = 10u;
+    const auto searchTerm = "Updated version: "sv, terminationChars = "\n"sv;
+    auto chunk = string();
+    chunk.reserve(chunkSize);
+    while (chunk.size() + 80 < chunkSize) {
+        chunk += "[ 42%] Building CXX object CMakeFiles/c++utilities.dir/io/buffersearch.cpp.o\n";
+    }
+    auto lastChunk = chunk + "Updated version: 1.2.3\n";
+
+    auto hits = 0u;
+    auto t1 = DateTime::exactGmtNow();
+    for (auto r = 0u; r != iterations; ++r) {
+        auto result = string();
+        for (auto i = 0u; i != chunkCount; ++i) {
+            hits += processCharByChar(searchTerm, terminationChars, i + 1 == chunkCount ? lastChunk : chunk, result) != nullptr;
+        }
+    }
+    auto t2 = DateTime::exactGmtNow();
+    const auto diff1 = t2 - t1;
+    cout << "char by char: " << diff1.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    for (auto r = 0u; r != iterations; ++r) {
+        auto bs = BufferSearch(searchTerm, terminationChars, "Starting build", [&hits](BufferSearch &, string &&) { ++hits; });
+        for (auto i = 0u; i != chunkCount; ++i) {
+            bs(i + 1 == chunkCount ? lastChunk : chunk);
+        }
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diff2 = t2 - t1;
+    cout << "BufferSearch: " << diff2.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    cout << "hits (should be " << 2 * iterations << "): " << hits << endl;
+    cout << "factor (char by char / BufferSearch): " << (static_cast<double>(diff1.totalTicks()) / static_cast<double>(diff2.totalTicks())) << endl;
+
+    return 0;
+}
@@ -18,6 +18,7 @@ using namespace CppUtilities;
 #endif
 
 using namespace std;
+using namespace CppUtilities::Literals;
 
 using namespace CPPUNIT_NS;
 
@@ -212,28 +213,21 @@ void assertEqual(const char *message, const std::uint8_t *expectedValues, size_t
  */
 void ConversionTests::testStringEncodingConversions()
 {
-#ifndef CPP_UTILITIES_NO_ICONV
     // define test string "ABCD" for the different encodings
     const std::uint8_t simpleString[] = { 'A', 'B', 'C', 'D' };
     const std::uint16_t simpleUtf16LEString[] = { 0x0041, 0x0042, 0x0043, 0x0044 };
     const std::uint16_t simpleUtf16BEString[] = { 0x4100, 0x4200, 0x4300, 0x4400 };
     // define test string "ABÖCD" for the different encodings
-    const std::uint8_t latin1String[] = { 'A', 'B', 0xD6, 'C', 'D' };
     const std::uint8_t utf8String[] = { 'A', 'B', 0xC3, 0x96, 'C', 'D' };
     const std::uint16_t utf16LEString[] = { 0x0041, 0x0042, 0x00D6, 0x0043, 0x0044 };
     const std::uint16_t utf16BEString[] = { 0x4100, 0x4200, 0xD600, 0x4300, 0x4400 };
-    // test conversion to UTF-8
-    assertEqual("Latin-1 to UTF-8 (simple)", simpleString, 4, convertLatin1ToUtf8(reinterpret_cast<const char *>(simpleString), 4));
-    assertEqual("Latin-1 to UTF-8", utf8String, 6, convertLatin1ToUtf8(reinterpret_cast<const char *>(latin1String), 5));
+    // test conversion between UTF-8 and UTF-16
     assertEqual(
         "UTF-16LE to UTF-8 (simple)", simpleString, 4, convertUtf16LEToUtf8(reinterpret_cast<const char *>(LE_STR_FOR_ENDIANNESS(simpleUtf16)), 8));
     assertEqual("UTF-16LE to UTF-8", utf8String, 6, convertUtf16LEToUtf8(reinterpret_cast<const char *>(LE_STR_FOR_ENDIANNESS(utf16)), 10));
     assertEqual(
         "UTF-16BE to UTF-8 (simple)", simpleString, 4, convertUtf16BEToUtf8(reinterpret_cast<const char *>(BE_STR_FOR_ENDIANNESS(simpleUtf16)), 8));
     assertEqual("UTF-16BE to UTF-8", utf8String, 6, convertUtf16BEToUtf8(reinterpret_cast<const char *>(BE_STR_FOR_ENDIANNESS(utf16)), 10));
-    // test conversion from UTF-8
-    assertEqual("UTF-8 to Latin-1 (simple)", simpleString, 4, convertUtf8ToLatin1(reinterpret_cast<const char *>(simpleString), 4));
-    assertEqual("UTF-8 to Latin-1", latin1String, 5, convertUtf8ToLatin1(reinterpret_cast<const char *>(utf8String), 6));
     assertEqual("UTF-8 to UFT-16LE (simple)", reinterpret_cast<const std::uint8_t *>(LE_STR_FOR_ENDIANNESS(simpleUtf16)), 8,
         convertUtf8ToUtf16LE(reinterpret_cast<const char *>(simpleString), 4));
     assertEqual("UTF-8 to UFT-16LE", reinterpret_cast<const std::uint8_t *>(LE_STR_FOR_ENDIANNESS(utf16)), 10,
@@ -242,7 +236,123 @@ void ConversionTests::testStringEncodingConversions()
         convertUtf8ToUtf16BE(reinterpret_cast<const char *>(simpleString), 4));
     assertEqual("UTF-8 to UFT-16BE", reinterpret_cast<const std::uint8_t *>(BE_STR_FOR_ENDIANNESS(utf16)), 10,
         convertUtf8ToUtf16BE(reinterpret_cast<const char *>(utf8String), 6));
+
+    // test conversion of longer strings with ASCII runs, surrogate pairs and incomplete sequence at the end
+    const auto longUtf8 = "ID3v2 title with umlauts (äöü), an emoji (\xF0\x9F\x8E\xB5) and a long ASCII tail 0123456789abcdef\xE2\x82"s;
+    const auto longUtf16 = u"ID3v2 title with umlauts (äöü), an emoji (\U0001F3B5) and a long ASCII tail 0123456789abcdef"s;
+    auto longUtf16LE = std::string(), longUtf16BE = std::string();
+    for (const auto unit : longUtf16) {
+        longUtf16LE += static_cast<char>(unit & 0xFF);
+        longUtf16LE += static_cast<char>(unit >> 8);
+        longUtf16BE += static_cast<char>(unit >> 8);
+        longUtf16BE += static_cast<char>(unit & 0xFF);
+    }
+    const auto toString = [](const StringData &data) { return std::string(data.first.get(), data.second); };
+    CPPUNIT_ASSERT_EQUAL(longUtf16LE, toString(convertUtf8ToUtf16LE(longUtf8.data(), longUtf8.size())));
+    CPPUNIT_ASSERT_EQUAL(longUtf16BE, toString(convertUtf8ToUtf16BE(longUtf8.data(), longUtf8.size())));
+    CPPUNIT_ASSERT_EQUAL(longUtf8.substr(0, longUtf8.size() - 2), toString(convertUtf16LEToUtf8(longUtf16LE.data(), longUtf16LE.size())));
+    CPPUNIT_ASSERT_EQUAL(longUtf8.substr(0, longUtf8.size() - 2), toString(convertUtf16BEToUtf8(longUtf16BE.data(), longUtf16BE.size())));
+
+    // test rejecting invalid input
+    CPPUNIT_ASSERT_THROW_MESSAGE("unexpected continuation byte", convertUtf8ToUtf16LE("a\x80", 2), ConversionException);
+    CPPUNIT_ASSERT_THROW_MESSAGE("overlong encoding", convertUtf8ToUtf16LE("\xC0\xAF", 2), ConversionException);
+    CPPUNIT_ASSERT_THROW_MESSAGE("encoded surrogate", convertUtf8ToUtf16BE("\xED\xA0\x80", 3), ConversionException);
+    CPPUNIT_ASSERT_THROW_MESSAGE("beyond U+10FFFF", convertUtf8ToUtf16BE("\xF4\x90\x80\x80", 4), ConversionException);
+    CPPUNIT_ASSERT_THROW_MESSAGE("unpaired low surrogate", convertUtf16LEToUtf8("\x00\xDC", 2), ConversionException);
+    CPPUNIT_ASSERT_THROW_MESSAGE("unpaired high surrogate", convertUtf16BEToUtf8("\xD8\x00\x00\x41", 4), ConversionException);
+
+    // test converting in chunks into a small buffer
+    for (const auto endianness : { Utf16Endianness::LittleEndian, Utf16Endianness::BigEndian }) {
+        const auto &expectedUtf16 = endianness == Utf16Endianness::LittleEndian ? longUtf16LE : longUtf16BE;
+        auto toUtf16 = Utf8ToUtf16Converter(endianness);
+        auto toUtf8 = Utf16ToUtf8Converter(endianness);
+        auto utf16 = std::string(), utf8 = std::string();
+        char buffer[5];
+        for (auto i = 0_st; i != longUtf8.size();) {
+            const auto res = toUtf16.convert(std::string_view(longUtf8).substr(i, 1), buffer, sizeof(buffer));
+            CPPUNIT_ASSERT(res.status != UnicodeConversionStatus::InvalidInput);
+            utf16.append(buffer, res.bytesWritten);
+            i += res.bytesRead;
+        }
+        CPPUNIT_ASSERT_EQUAL(expectedUtf16, utf16);
+        CPPUNIT_ASSERT_MESSAGE("incomplete sequence pending", toUtf16.hasPendingInput());
+        for (auto i = 0_st; i != utf16.size();) {
+            const auto res = toUtf8.convert(std::string_view(utf16).substr(i, 3), buffer, sizeof(buffer));
+            CPPUNIT_ASSERT(res.status != UnicodeConversionStatus::InvalidInput);
+            utf8.append(buffer, res.bytesWritten);
+            i += res.bytesRead;
+        }
+        CPPUNIT_ASSERT_EQUAL(longUtf8.substr(0, longUtf8.size() - 2), utf8);
+        CPPUNIT_ASSERT(!toUtf8.hasPendingInput());
+    }
+    auto toUtf16 = Utf8ToUtf16Converter();
+    char buffer[Utf8ToUtf16Converter::maxOutputSize(4)];
+    auto res = toUtf16.convert("ab\xFF"sv, buffer, 2);
+    CPPUNIT_ASSERT(res.status == UnicodeConversionStatus::OutputBufferTooSmall);
+    CPPUNIT_ASSERT_EQUAL(1_st, res.bytesRead);
+    CPPUNIT_ASSERT_EQUAL(2_st, res.bytesWritten);
+    res = toUtf16.convert("b\xFF"sv, buffer, sizeof(buffer));
+    CPPUNIT_ASSERT(res.status == UnicodeConversionStatus::InvalidInput);
+    CPPUNIT_ASSERT_EQUAL(1_st, res.bytesRead);
+    CPPUNIT_ASSERT_EQUAL(2_st, res.bytesWritten);
+
+    // test conversion between Latin-1 and UTF-8
+    const std::uint8_t latin1String[] = { 'A', 'B', 0xD6, 'C', 'D' };
+    assertEqual("Latin-1 to UTF-8 (simple)", simpleString, 4, convertLatin1ToUtf8(reinterpret_cast<const char *>(simpleString), 4));
+    assertEqual("Latin-1 to UTF-8", utf8String, 6, convertLatin1ToUtf8(reinterpret_cast<const char *>(latin1String), 5));
+    assertEqual("UTF-8 to Latin-1 (simple)", simpleString, 4, convertUtf8ToLatin1(reinterpret_cast<const char *>(simpleString), 4));
+    assertEqual("UTF-8 to Latin-1", latin1String, 5, convertUtf8ToLatin1(reinterpret_cast<const char *>(utf8String), 6));
+    const auto longLatin1 = "Die \xC4rzte - Schrei nach Liebe (a long title with only ASCII characters at the end) \xFF"s;
+    const auto longLatin1AsUtf8 = "Die Ärzte - Schrei nach Liebe (a long title with only ASCII characters at the end) ÿ"s;
+    CPPUNIT_ASSERT_EQUAL(longLatin1AsUtf8, toString(convertLatin1ToUtf8(longLatin1.data(), longLatin1.size())));
+    CPPUNIT_ASSERT_EQUAL(longLatin1, toString(convertUtf8ToLatin1(longLatin1AsUtf8.data(), longLatin1AsUtf8.size())));
+    CPPUNIT_ASSERT_THROW_MESSAGE("not representable in Latin-1", convertUtf8ToLatin1("\xE2\x82\xAC", 3), ConversionException);
+    CPPUNIT_ASSERT_THROW_MESSAGE("invalid UTF-8", convertUtf8ToLatin1("\xC3(", 2), ConversionException);
+    auto toLatin1 = Utf8ToLatin1Converter();
+    auto latin1 = std::string();
+    for (auto i = 0_st; i != longLatin1AsUtf8.size();) {
+        const auto chunkRes = toLatin1.convert(std::string_view(longLatin1AsUtf8).substr(i, 3), buffer, 2);
+        CPPUNIT_ASSERT(chunkRes.status != UnicodeConversionStatus::InvalidInput);
+        latin1.append(buffer, chunkRes.bytesWritten);
+        i += chunkRes.bytesRead;
+    }
+    CPPUNIT_ASSERT_EQUAL(longLatin1, latin1);
+    latin1.resize(Latin1ToUtf8Converter::maxOutputSize(longLatin1.size()));
+    res = Latin1ToUtf8Converter().convert(longLatin1, latin1.data(), latin1.size());
+    CPPUNIT_ASSERT(res.status == UnicodeConversionStatus::Ok);
+    CPPUNIT_ASSERT_EQUAL(longLatin1AsUtf8, latin1.substr(0, res.bytesWritten));
+
+#ifndef CPP_UTILITIES_NO_ICONV
     CPPUNIT_ASSERT_THROW(convertString("invalid charset", "UTF-8", "foo", 3, 1.0f), ConversionException);
+
+    // test converting repeatedly with cached descriptor
+    for (auto i = 0; i != 3; ++i) {
+        assertEqual("Latin-1 to UTF-16BE via convertString()", reinterpret_cast<const std::uint8_t *>(BE_STR_FOR_ENDIANNESS(utf16)), 10,
+            convertString("ISO-8859-1", "UTF-16BE", reinterpret_cast<const char *>(latin1String), 5, 0.1f));
+        CPPUNIT_ASSERT_THROW(convertString("UTF-8", "ISO-8859-1", "\xFF", 1), ConversionException);
+    }
+
+    // test reusable converter
+    auto converter = StringConverter("UTF-8", "ISO-8859-1");
+    auto output = std::string();
+    CPPUNIT_ASSERT_THROW(converter.convert("a\xFF"sv, output), ConversionException);
+    converter.convert(std::string_view(reinterpret_cast<const char *>(utf8String), 6), output);
+    CPPUNIT_ASSERT_EQUAL(std::string(reinterpret_cast<const char *>(latin1String), 5), output);
+    auto movedConverter = std::move(converter);
+    movedConverter.convert("foo"sv, output);
+    CPPUNIT_ASSERT_EQUAL("foo"s, output);
+    assertEqual("UTF-8 to Latin-1 via StringConverter", latin1String, 5, movedConverter.convert(reinterpret_cast<const char *>(utf8String), 6));
+    CPPUNIT_ASSERT_THROW(StringConverter("invalid charset", "UTF-8"), ConversionException);
+
+    // test growing the output repeatedly and shrinking it to the final size again
+    auto growingConverter = StringConverter("ISO-8859-1", "UTF-32BE", 0.1f);
+    growingConverter.convert(std::string(1000, 'a'), output);
+    CPPUNIT_ASSERT_EQUAL(4000_st, output.size());
+    CPPUNIT_ASSERT_EQUAL("\0\0\0a"s, output.substr(3996));
+    const auto capacity = output.capacity();
+    growingConverter.convert("b"sv, output);
+    CPPUNIT_ASSERT_EQUAL("\0\0\0b"s, output);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("capacity reused", capacity, output.capacity());
 #endif
 }
 
@@ -297,10 +407,78 @@ void ConversionTests::testStringConversions()
     CPPUNIT_ASSERT_EQUAL_MESSAGE("negative limit", -2147483647, stringToNumber<std::int32_t>("-2147483647", 10));
 #endif
 
+    // stringToNumber() with all numbers of digits (to cover parsing 8 digits at a time and the remainder)
+    for (auto number = std::uint64_t(1), digits = std::uint64_t(1); digits != 20; number = number * 10 + (++digits % 10)) {
+        CPPUNIT_ASSERT_EQUAL(number, stringToNumber<std::uint64_t>(numberToString(number)));
+        CPPUNIT_ASSERT_EQUAL(-static_cast<std::int64_t>(number), stringToNumber<std::int64_t>(numberToString(-static_cast<std::int64_t>(number))));
+        CPPUNIT_ASSERT_EQUAL(number, bufferToNumber<std::uint64_t>(numberToString(number).data(), static_cast<std::size_t>(digits)));
+    }
+    CPPUNIT_ASSERT_EQUAL(numeric_limits<std::uint64_t>::max(), stringToNumber<std::uint64_t>("18446744073709551615"));
+    CPPUNIT_ASSERT_EQUAL(numeric_limits<std::int64_t>::min(), stringToNumber<std::int64_t>("-9223372036854775808"s));
+    CPPUNIT_ASSERT_EQUAL(numeric_limits<std::int8_t>::min(), stringToNumber<std::int8_t>("-128"s));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("limit with leading space", numeric_limits<std::int8_t>::min(), stringToNumber<std::int8_t>(" -128"s));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("limit with leading space", numeric_limits<std::int8_t>::min(), stringToNumber<std::int8_t>(" -128"));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("limit with leading space", numeric_limits<std::int8_t>::min(), stringToNumber<std::int8_t>(u" -128"s));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(
+        "limit with leading space", numeric_limits<std::int64_t>::min(), stringToNumber<std::int64_t>(u" -9223372036854775808"));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("limit with leading space", numeric_limits<std::int8_t>::max(), stringToNumber<std::int8_t>(" 127"s));
+    CPPUNIT_ASSERT_THROW_MESSAGE("overflow with leading space", stringToNumber<std::int8_t>(" -129"s), ConversionException);
+    CPPUNIT_ASSERT_THROW_MESSAGE("overflow with leading space", stringToNumber<std::int8_t>(" 128"), ConversionException);
+    CPPUNIT_ASSERT_EQUAL(1234, stringToNumber<std::int32_t>("12 34"s));
+    CPPUNIT_ASSERT_EQUAL(0u, stringToNumber<std::uint32_t>(""s));
+    CPPUNIT_ASSERT_THROW_MESSAGE("overflow", stringToNumber<std::uint64_t>("18446744073709551616"), ConversionException);
+    CPPUNIT_ASSERT_THROW_MESSAGE("overflow", stringToNumber<std::uint8_t>("256"s), ConversionException);
+    CPPUNIT_ASSERT_THROW_MESSAGE("overflow", stringToNumber<std::int8_t>("-129"s), ConversionException);
+    CPPUNIT_ASSERT_THROW_MESSAGE("negative unsigned", stringToNumber<std::uint32_t>("-1"s), ConversionException);
+    CPPUNIT_ASSERT_THROW_MESSAGE("invalid character", stringToNumber<std::uint32_t>("1234567:"s), ConversionException);
+    CPPUNIT_ASSERT_THROW_MESSAGE("invalid character", stringToNumber<std::uint32_t>("123456789/"s), ConversionException);
+
+    // stringToNumbers()
+    CPPUNIT_ASSERT_EQUAL(vector<std::int32_t>({ 1, -2, 3, 40000000 }), stringToNumbers<std::int32_t>("1,-2\n\n3,40000000\n", ",\n"));
+    CPPUNIT_ASSERT_EQUAL(vector<std::uint16_t>({ 0xFF, 0x10 }), stringToNumbers<std::uint16_t>("ff;10", ";", 16));
+    CPPUNIT_ASSERT_EQUAL(vector<std::uint32_t>(), stringToNumbers<std::uint32_t>(",,"));
+    auto parsedNumbers = vector<std::uint32_t>({ 5 });
+    stringToNumbers(parsedNumbers, "6 7 8", " ");
+    CPPUNIT_ASSERT_EQUAL(vector<std::uint32_t>({ 5, 6, 7, 8 }), parsedNumbers);
+    CPPUNIT_ASSERT_THROW(stringToNumbers(parsedNumbers, "9,x"), ConversionException);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(5), parsedNumbers.size());
+
     // stringToNumber() / numberToString() with floating point numbers
     CPPUNIT_ASSERT_EQUAL(1.5f, stringToNumber<float>(numberToString(1.5f)));
     CPPUNIT_ASSERT_EQUAL(1.5, stringToNumber<double>(numberToString(1.5)));
     CPPUNIT_ASSERT_EQUAL(-10.25, stringToNumber<double>("-10.25"));
+#ifdef __cpp_lib_to_chars
+    CPPUNIT_ASSERT_EQUAL("0.30000000000000004"s, numberToString(0.1 + 0.2));
+    CPPUNIT_ASSERT_EQUAL("123456789"s, numberToString(123456789.0));
+    CPPUNIT_ASSERT(L"-0.5"s == (numberToString<double, wstring>(-0.5)));
+#endif
+
+    // numberToString() with limits, small types and different bases
+    CPPUNIT_ASSERT_EQUAL("-9223372036854775808"s, numberToString(numeric_limits<std::int64_t>::min()));
+    CPPUNIT_ASSERT_EQUAL("18446744073709551615"s, numberToString(numeric_limits<std::uint64_t>::max()));
+    CPPUNIT_ASSERT_EQUAL("-128"s, numberToString(numeric_limits<std::int8_t>::min()));
+    CPPUNIT_ASSERT_EQUAL("255"s, numberToString(numeric_limits<std::uint8_t>::max()));
+    CPPUNIT_ASSERT_EQUAL("-1010"s, numberToString(-10, 2));
+    CPPUNIT_ASSERT_EQUAL("FF"s, numberToString(255u, 16u));
+    CPPUNIT_ASSERT(L"-42"s == (numberToString<int, wstring>(-42)));
+    for (const auto number : { 0u, 9u, 10u, 99u, 100u, 101u, 999u, 1000u, 4294967295u }) {
+        CPPUNIT_ASSERT_EQUAL(std::to_string(number), numberToString(number));
+    }
+
+    // numberToString() appending to an existing string
+    auto numbers = "numbers:"s;
+    for (const auto number : { -1, 0, 1234567 }) {
+        numbers += ' ';
+        numberToString(numbers, number);
+    }
+    numbers += ' ';
+    numberToString(numbers, 255u, 16u);
+    numbers += ' ';
+    numberToString(numbers, 2.5);
+    CPPUNIT_ASSERT_EQUAL("numbers: -1 0 1234567 FF 2.5"s, numbers);
+    auto wideNumbers = wstring();
+    numberToString(wideNumbers, -12);
+    CPPUNIT_ASSERT(L"-12"s == wideNumbers);
 
     // interpretIntegerAsString()
     CPPUNIT_ASSERT_EQUAL("TEST"s, interpretIntegerAsString<std::uint32_t>(0x54455354));
@@ -332,6 +510,42 @@ void ConversionTests::testStringConversions()
     CPPUNIT_ASSERT_EQUAL("(a) (ab) (ABC) (s)"s, splitJoinTest);
     splitJoinTest = joinStrings(splitString<vector<string>>(",a,,ab,ABC,s"s, ","s, EmptyPartsTreat::Merge), " "s, false, "("s, ")"s);
     CPPUNIT_ASSERT_EQUAL("(a,ab) (ABC) (s)"s, splitJoinTest);
+    CPPUNIT_ASSERT_EQUAL(",a,"s, joinStrings({ ""s, "a"s, ""s }, ","));
+    CPPUNIT_ASSERT_EQUAL(string(), joinStrings({ ""s, ""s }, ",", true));
+    CPPUNIT_ASSERT_EQUAL("a/b"s, (joinStrings<vector<string_view>, string>({ "a"sv, "b"sv }, "/")));
+    splitJoinTest = "files: ";
+    joinStrings(splitJoinTest, vector<string>{ "foo", "", "bar" }, ", ", true, "'", "'");
+    CPPUNIT_ASSERT_EQUAL("files: 'foo', 'bar'"s, splitJoinTest);
+    splitJoinTest.clear();
+    joinStrings(splitJoinTest, { "foo"s, "bar"s });
+    CPPUNIT_ASSERT_EQUAL("foobar"s, splitJoinTest);
+    CPPUNIT_ASSERT_EQUAL("a\nb"s, toMultiline({ "a"s, "b"s }));
+
+    // splitStringLazily() yields the same parts as splitString()
+    const auto lazySplit = [](std::string_view str, std::string_view delimiter, EmptyPartsTreat emptyPartsRole, int maxParts) {
+        auto parts = vector<string>();
+        for (const auto part : splitStringLazily(str, delimiter, emptyPartsRole, maxParts)) {
+            parts.emplace_back(part);
+        }
+        return parts;
+    };
+    for (const auto emptyPartsRole : { EmptyPartsTreat::Keep, EmptyPartsTreat::Omit, EmptyPartsTreat::Merge }) {
+        for (const auto maxParts : { -1, 1, 2, 3, 4 }) {
+            for (const auto *const str : { "", ",", ",,", "a", "1,2,3", "12,34,56,", "1,2,,3,4,,5", ",a,,ab,ABC,s", ",,a,,,b,,", "a,b,,,c" }) {
+                CPPUNIT_ASSERT_EQUAL_MESSAGE(str, splitString<vector<string>>(str, ",", emptyPartsRole, maxParts),
+                    lazySplit(str, ",", emptyPartsRole, maxParts));
+            }
+            CPPUNIT_ASSERT_EQUAL(splitString<vector<string>>("a::b::::c::", "::", emptyPartsRole, maxParts),
+                lazySplit("a::b::::c::", "::", emptyPartsRole, maxParts));
+        }
+    }
+    auto lazySplitIterator = splitStringLazily("foo\nbar\n", "\n").begin();
+    CPPUNIT_ASSERT_EQUAL("foo"sv, *lazySplitIterator++);
+    CPPUNIT_ASSERT_EQUAL("bar"sv, *lazySplitIterator);
+    CPPUNIT_ASSERT_EQUAL(""sv, *++lazySplitIterator);
+    CPPUNIT_ASSERT(++lazySplitIterator == SplitStringIterator<char>());
+    const auto lazyParts = splitStringLazily("a,b", ",");
+    CPPUNIT_ASSERT_EQUAL(vector<string>({ "a", "b" }), vector<string>(lazyParts.begin(), lazyParts.end()));
 
     // findAndReplace()
     string findReplaceTest("findAndReplace()");
@@ -389,6 +603,53 @@ void ConversionTests::testStringConversions()
     CPPUNIT_ASSERT_NO_THROW(decodeBase64(encodedBase64Data.data(), static_cast<std::uint32_t>(encodedBase64Data.size())));
     // test check for invalid size
     CPPUNIT_ASSERT_THROW(decodeBase64(encodedBase64Data.data(), 3), ConversionException);
+    // test check for invalid padding and characters
+    CPPUNIT_ASSERT_THROW(decodeBase64("Zm9v=mFy", 8), ConversionException);
+    CPPUNIT_ASSERT_THROW(decodeBase64("Z===", 4), ConversionException);
+    CPPUNIT_ASSERT_THROW(decodeBase64("Zg==Zg==", 8), ConversionException);
+    CPPUNIT_ASSERT_THROW(decodeBase64("Zm9v YmFy", 9), ConversionException);
+    CPPUNIT_ASSERT_THROW(decodeBase64("Zm9v-mFy", 8), ConversionException);
+
+    // encodeBase64() / decodeBase64() with caller-provided buffers
+    CPPUNIT_ASSERT_EQUAL("Zm9vYmE="s, encodeBase64(reinterpret_cast<const std::uint8_t *>("fooba"), 5));
+    char base64Buffer[Base64Encoder::maxOutputSize(6)];
+    CPPUNIT_ASSERT_EQUAL(std::size_t(8), encodeBase64(reinterpret_cast<const std::uint8_t *>("foobar"), 6, base64Buffer));
+    CPPUNIT_ASSERT_EQUAL("Zm9vYmFy"sv, std::string_view(base64Buffer, 8));
+    std::uint8_t decodedBase64Buffer[Base64Decoder::maxOutputSize(20)];
+    const auto pemBody = "\nZm9v\r\nYmE=\n"sv;
+    CPPUNIT_ASSERT_THROW(decodeBase64(pemBody.data(), pemBody.size(), decodedBase64Buffer), ConversionException);
+    CPPUNIT_ASSERT_EQUAL(
+        std::size_t(5), decodeBase64(pemBody.data(), pemBody.size(), decodedBase64Buffer, Base64DecodeOptions::SkipWhitespace));
+    CPPUNIT_ASSERT_EQUAL("fooba"sv, std::string_view(reinterpret_cast<const char *>(decodedBase64Buffer), 5));
+
+    // Base64Encoder / Base64Decoder with chunks of different sizes
+    const auto encodedBase64Size = Base64Encoder::maxOutputSize(sizeof(originalBase64Data));
+    for (const auto chunkSize : { std::size_t(1), std::size_t(2), std::size_t(5), std::size_t(17), std::size_t(100) }) {
+        auto encoder = Base64Encoder();
+        auto encoded = std::string(encodedBase64Size, '\0');
+        auto encodedSize = std::size_t();
+        for (auto offset = std::size_t(); offset < sizeof(originalBase64Data); offset += chunkSize) {
+            const auto size = std::min(chunkSize, sizeof(originalBase64Data) - offset);
+            encodedSize += encoder.encode(originalBase64Data + offset, size, encoded.data() + encodedSize);
+        }
+        encodedSize += encoder.finish(encoded.data() + encodedSize);
+        CPPUNIT_ASSERT_EQUAL(encodedBase64Size, encodedSize);
+        CPPUNIT_ASSERT_EQUAL(encodeBase64(originalBase64Data, sizeof(originalBase64Data)), encoded);
+
+        auto decoder = Base64Decoder();
+        auto decoded = std::make_unique<std::uint8_t[]>(Base64Decoder::maxOutputSize(encodedSize));
+        auto decodedSize = std::size_t();
+        for (auto offset = std::size_t(); offset < encodedSize; offset += chunkSize) {
+            const auto size = std::min(chunkSize, encodedSize - offset);
+            decodedSize += decoder.decode(encoded.data() + offset, size, decoded.get() + decodedSize);
+        }
+        CPPUNIT_ASSERT_NO_THROW(decoder.finish());
+        CPPUNIT_ASSERT_EQUAL(sizeof(originalBase64Data), decodedSize);
+        CPPUNIT_ASSERT_EQUAL(0, std::memcmp(originalBase64Data, decoded.get(), decodedSize));
+    }
+    auto decoder = Base64Decoder();
+    decoder.decode("Zm9", 3, decodedBase64Buffer);
+    CPPUNIT_ASSERT_THROW(decoder.finish(), ConversionException);
 
     // dataSizeToString(), bitrateToString()
     CPPUNIT_ASSERT_EQUAL("512 bytes"s, dataSizeToString(512ull));
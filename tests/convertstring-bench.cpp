@@ -0,0 +1,78 @@
+#include "../chrono/datetime.h"
+#include "../conversion/stringconversion.h"
+
+#include <iconv.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace CppUtilities;
+
+/*!
+ * \brief Converts \a input like convertString() did before descriptors have been cached (opening a new descriptor for each call).
+ */
+static StringData convertStringViaNewDescriptor(const char *fromCharset, const char *toCharset, const string &input, size_t outputSize)
+{
+    const auto descriptor = iconv_open(toCharset, fromCharset);
+    auto *inputBuffer = const_cast<char *>(input.data());
+    auto inputBytesLeft = input.size(), outputBytesLeft = outputSize;
+    auto *const outputBuffer = static_cast<char *>(malloc(outputSize));
+    auto *currentOutputOffset = outputBuffer;
+    iconv(descriptor, &inputBuffer, &inputBytesLeft, &currentOutputOffset, &outputBytesLeft);
+    iconv_close(descriptor);
+    return StringData(unique_ptr<char[], StringDataDeleter>(outputBuffer), static_cast<size_t>(currentOutputOffset - outputBuffer));
+}
+
+int main()
+{
+    cout << "Benchmarking convertString() vs. its previous implementation" << endl;
+
+    // simulate text fields from legacy-encoded tags which are converted to UTF-16 one by one
+    constexpr auto fieldCount = 1000000u;
+    auto fields = vector<string>();
+    fields.reserve(fieldCount);
+    for (auto i = 0u; i != fieldCount; ++i) {
+        fields.emplace_back(i % 2 ? "Some Artist - Some Title " + to_string(i) : "Die \xC4rzte - Schrei nach Liebe " + to_string(i));
+    }
+
+    auto t1 = DateTime::exactGmtNow();
+    auto size1 = size_t();
+    for (const auto &field : fields) {
+        size1 += convertStringViaNewDescriptor("ISO-8859-1", "UTF-16LE", field, field.size() * 2).second;
+    }
+    auto t2 = DateTime::exactGmtNow();
+    const auto diff1 = t2 - t1;
+    cout << "previous implementation: " << diff1.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto size2 = size_t();
+    for (const auto &field : fields) {
+        size2 += convertString("ISO-8859-1", "UTF-16LE", field.data(), field.size(), 2.0f).second;
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diff2 = t2 - t1;
+    cout << "convertString(): " << diff2.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto size3 = size_t();
+    auto converter = StringConverter("ISO-8859-1", "UTF-16LE", 2.0f);
+    auto output = string();
+    for (const auto &field : fields) {
+        converter.convert(field, output);
+        size3 += output.size();
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diff3 = t2 - t1;
+    cout << "StringConverter with reused output: " << diff3.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    cout << "total size (should be equal): " << size1 << ", " << size2 << ", " << size3 << endl;
+    cout << "factor (previous / convertString()): " << (static_cast<double>(diff1.totalTicks()) / static_cast<double>(diff2.totalTicks()))
+         << endl;
+    cout << "factor (previous / StringConverter): " << (static_cast<double>(diff1.totalTicks()) / static_cast<double>(diff3.totalTicks()))
+         << endl;
+
+    return 0;
+}
@@ -45,6 +45,7 @@ std::ostream &operator<<(std::ostream &out, const std::wstring &s)
 
 #include <algorithm>
 #include <cstddef>
+#include <filesystem>
 #include <fstream>
 #include <regex>
 #include <sstream>
@@ -71,6 +72,7 @@ class IoTests : public TestFixture {
     CPPUNIT_TEST(testBinaryWriter);
     CPPUNIT_TEST(testBitReader);
     CPPUNIT_TEST(testBufferSearch);
+    CPPUNIT_TEST(testMultiBufferSearch);
     CPPUNIT_TEST(testPathUtilities);
     CPPUNIT_TEST(testIniFile);
     CPPUNIT_TEST(testAdvancedIniFile);
@@ -81,6 +83,7 @@ class IoTests : public TestFixture {
     CPPUNIT_TEST(testAnsiEscapeCodes);
 #ifdef CPP_UTILITIES_USE_NATIVE_FILE_BUFFER
     CPPUNIT_TEST(testNativeFileStream);
+    CPPUNIT_TEST(testNativeFileStreamScatterGather);
 #endif
 #ifdef CPP_UTILITIES_USE_LIBARCHIVE
     CPPUNIT_TEST(testExtractingArchive);
@@ -95,6 +98,7 @@ public:
     void testBinaryWriter();
     void testBitReader();
     void testBufferSearch();
+    void testMultiBufferSearch();
     void testPathUtilities();
     void testIniFile();
     void testAdvancedIniFile();
@@ -105,6 +109,7 @@ public:
     void testAnsiEscapeCodes();
 #ifdef CPP_UTILITIES_USE_NATIVE_FILE_BUFFER
     void testNativeFileStream();
+    void testNativeFileStreamScatterGather();
 #endif
 #ifdef CPP_UTILITIES_USE_LIBARCHIVE
     void testExtractingArchive();
@@ -350,10 +355,109 @@ void IoTests::testBufferSearch()
     std::strcpy(buffer, "... Starting build ...");
     bs(buffer, 22);
     CPPUNIT_ASSERT(!hasResult);
+
+    // find term after a partial match which turned out to be a prefix of the actual match; split term across chunks
+    bs.reset();
+    expectedResult = "1.2";
+    bs("foo UpdatedUpdated ver");
+    CPPUNIT_ASSERT(!hasResult);
+    bs("sion: 1.2\n");
+    CPPUNIT_ASSERT(hasResult);
+
+    // stop after give-up term
+    bs.reset();
+    hasResult = false;
+    bs("Starting build\nUpdated version: 1.2\n");
+    CPPUNIT_ASSERT(!hasResult);
+
+    // find self-overlapping terms after a mismatch within a partial match which is a prefix of the actual match
+    auto selfOverlappingResult = std::string();
+    const auto storeResult = [&](BufferSearch &, std::string &&result) { selfOverlappingResult = std::move(result); };
+    auto aab = BufferSearch("aab", ";", std::string_view(), storeResult);
+    aab("xaaab:z;");
+    CPPUNIT_ASSERT_EQUAL(":z"s, selfOverlappingResult);
+    selfOverlappingResult.clear();
+    auto abac = BufferSearch("abac", ";", std::string_view(), storeResult);
+    abac("abab");
+    abac("ac:z;");
+    CPPUNIT_ASSERT_EQUAL(":z"s, selfOverlappingResult);
+
+    // give up on self-overlapping give-up terms as well
+    selfOverlappingResult.clear();
+    auto giveUpOnAab = BufferSearch(":z", ";", "aab", storeResult);
+    giveUpOnAab("xaaab:z;");
+    CPPUNIT_ASSERT_EQUAL(std::string(), selfOverlappingResult);
+    auto giveUpOnAbac = BufferSearch(":z", ";", "abac", storeResult);
+    giveUpOnAbac("ababac:z;");
+    CPPUNIT_ASSERT_EQUAL(std::string(), selfOverlappingResult);
+}
+
+/*!
+ * \brief Tests the MultiBufferSearch class.
+ */
+void IoTests::testMultiBufferSearch()
+{
+    // setup search to test
+    auto expectedTerm = MultiBufferSearch::noTerm;
+    auto expectedResult = std::string();
+    auto hasResult = false;
+    auto bs = MultiBufferSearch({ "Updated version: ", "Error: ", "rror: ", "Warning: " }, "\t\n", "Starting build",
+        [&](MultiBufferSearch &, std::size_t term, std::string &&result) {
+            CPPUNIT_ASSERT_EQUAL(expectedTerm, term);
+            CPPUNIT_ASSERT_EQUAL(expectedResult, result);
+            CPPUNIT_ASSERT_MESSAGE("callback only invoked once", !hasResult);
+            hasResult = true;
+        });
+
+    // feed data into the search, splitting the search term and result across chunks
+    char buffer[30] = { 0 };
+    bs(buffer, 0);
+    CPPUNIT_ASSERT(!hasResult);
+    std::strcpy(buffer, "Starting Updated");
+    CPPUNIT_ASSERT(bs.process(std::string_view(buffer, 16)) == nullptr);
+    CPPUNIT_ASSERT(!hasResult);
+    std::strcpy(buffer, " version: some ");
+    bs(buffer, 15);
+    CPPUNIT_ASSERT(!hasResult);
+    CPPUNIT_ASSERT_EQUAL(0_st, bs.matchedTerm());
+    expectedTerm = 0;
+    expectedResult = "some version number";
+    std::strcpy(buffer, "version number\tmore chars");
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::ptrdiff_t>(14), bs.process(buffer, 25) - buffer);
+    CPPUNIT_ASSERT(hasResult);
+
+    // the longest term ending at a position is reported
+    bs.reset();
+    hasResult = false;
+    expectedTerm = 1;
+    expectedResult = "disk full";
+    bs("foo Error: disk full\n");
+    CPPUNIT_ASSERT(hasResult);
+
+    // the give-up term stops the search
+    bs.reset();
+    hasResult = false;
+    bs("... Starting build ... Warning: foo\n");
+    CPPUNIT_ASSERT(!hasResult);
+    CPPUNIT_ASSERT(bs.hasGivenUp());
+    CPPUNIT_ASSERT_EQUAL(MultiBufferSearch::noTerm, bs.matchedTerm());
+
+    // without termination chars the callback is invoked directly after the term
+    auto terms = std::vector<std::string_view>{ "ab", "bc" };
+    auto noTerminationChars = MultiBufferSearch(terms.data(), terms.size(), std::string_view(), std::string_view(),
+        [&](MultiBufferSearch &, std::size_t term, std::string &&result) {
+            CPPUNIT_ASSERT_EQUAL(1_st, term);
+            CPPUNIT_ASSERT_EQUAL(std::string(), result);
+            hasResult = true;
+        });
+    hasResult = false;
+    std::strcpy(buffer, "xxbcd");
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::ptrdiff_t>(4), noTerminationChars.process(buffer, 5) - buffer);
+    CPPUNIT_ASSERT(hasResult);
 }
 
 /*!
- * \brief Tests fileName() and removeInvalidChars().
+ * \brief Tests fileName(), removeInvalidChars(), PathComponents and normalizePath().
  */
 void IoTests::testPathUtilities()
 {
@@ -368,6 +472,32 @@ void IoTests::testPathUtilities()
     string invalidPath("lib/c++uti*lities.so?");
     removeInvalidChars(invalidPath);
     CPPUNIT_ASSERT(invalidPath == "libc++utilities.so");
+    auto invalidPaths = "valid.so|in:val*id.so\"\"\"täst?.so"s;
+    auto invalidPathEnds = std::vector<std::size_t>{ 8, 21, 24, 33 };
+    removeInvalidChars(invalidPaths, invalidPathEnds);
+    CPPUNIT_ASSERT_EQUAL("valid.soinvalid.sotäst.so"s, invalidPaths);
+    CPPUNIT_ASSERT_EQUAL((std::vector<std::size_t>{ 8, 18, 18, 26 }), invalidPathEnds);
+
+    auto components = std::vector<std::string_view>();
+    for (const auto component : PathComponents("//usr\\lib//libc++utilities.so/")) {
+        components.emplace_back(component);
+    }
+    CPPUNIT_ASSERT_EQUAL(3_st, components.size());
+    CPPUNIT_ASSERT_EQUAL("usr"sv, components[0]);
+    CPPUNIT_ASSERT_EQUAL("lib"sv, components[1]);
+    CPPUNIT_ASSERT_EQUAL("libc++utilities.so"sv, components[2]);
+    CPPUNIT_ASSERT_MESSAGE("no components in empty path", PathComponents(std::string_view()).begin() == PathComponents("//").end());
+
+    char normalizedBuffer[32];
+    CPPUNIT_ASSERT_EQUAL("/usr/lib64/libfoo.so"sv, normalizePath("/usr//lib/../lib64/./libfoo.so", normalizedBuffer));
+    CPPUNIT_ASSERT_EQUAL("a/"sv, normalizePath("a\\b/..", normalizedBuffer));
+    CPPUNIT_ASSERT_EQUAL("../c"sv, normalizePath("../a/../b/../c", normalizedBuffer));
+    CPPUNIT_ASSERT_EQUAL("/"sv, normalizePath("/../..", normalizedBuffer));
+    CPPUNIT_ASSERT_EQUAL("."sv, normalizePath("a/..", normalizedBuffer));
+    CPPUNIT_ASSERT_EQUAL(std::string_view(), normalizePath(std::string_view(), normalizedBuffer));
+    auto pathToNormalize = "./x//y/.././z/"s;
+    normalizePath(pathToNormalize);
+    CPPUNIT_ASSERT_EQUAL("x/z/"s, pathToNormalize);
 
     const auto input = std::string_view("some/path/täst");
     const auto expected = input;
@@ -425,6 +555,61 @@ void IoTests::testIniFile()
     IniFile ini2;
     ini2.parse(outputFile);
     CPPUNIT_ASSERT(ini.data() == ini2.data());
+
+    // parse from buffer
+    const auto buffer = readFile(testFilePath("test.ini"));
+    IniFile ini3;
+    ini3.parse(std::string_view(buffer));
+    CPPUNIT_ASSERT(ini.data() == ini3.data());
+
+    // parse from buffer without copying
+    const auto views = IniFile::parseViews(buffer);
+    CPPUNIT_ASSERT_EQUAL(3_st, views.size());
+    CPPUNIT_ASSERT_EQUAL("scope 1"sv, views[1].first);
+    CPPUNIT_ASSERT_EQUAL(3_st, views[1].second.size());
+    CPPUNIT_ASSERT_EQUAL("key2"sv, views[1].second[1].first);
+    CPPUNIT_ASSERT_EQUAL("value=2"sv, views[1].second[1].second);
+    const auto *const valueData = views[1].second[1].second.data();
+    CPPUNIT_ASSERT_MESSAGE("view into buffer", valueData >= buffer.data() && valueData < buffer.data() + buffer.size());
+    CPPUNIT_ASSERT_EQUAL("value 1"sv, views[1].second[0].second);
+    CPPUNIT_ASSERT_EQUAL("key6"sv, views[2].second.back().first);
+
+    // load files resolving includes
+    const auto mainPath = workingCopyPath("include-main.ini", WorkingCopyMode::NoCopy);
+    const auto mirrorsPath = workingCopyPath("include-mirrors.ini", WorkingCopyMode::NoCopy);
+    const auto morePath = workingCopyPath("include-more.ini", WorkingCopyMode::NoCopy);
+    writeFile(mainPath, "[core]\nInclude = include-mirrors.ini\n[extra]\nInclude = include-mirrors.ini\nfoo = bar\n");
+    writeFile(mirrorsPath, "Server = a\nInclude = ./include-more.ini\n[mirrors]\nServer = c\n");
+    writeFile(morePath, "Server = b\nInclude = include-main.ini\n");
+    auto loader = IniFileLoader();
+    const auto checkLoadedFile = [](const IniFile &loadedIni, std::string_view expectedServers) {
+        auto servers = std::string();
+        for (const auto &[scopeName, fields] : loadedIni.data()) {
+            CPPUNIT_ASSERT_MESSAGE("include directives removed", fields.find("Include") == fields.end());
+            for (auto [field, end] = fields.equal_range("Server"); field != end; ++field) {
+                servers += scopeName % ':' % field->second + ' ';
+            }
+        }
+        CPPUNIT_ASSERT_EQUAL(std::string(expectedServers), servers);
+    };
+    const auto loadedIni = loader.load(mainPath);
+    CPPUNIT_ASSERT_EQUAL(4_st, loadedIni.data().size());
+    CPPUNIT_ASSERT_EQUAL("extra"s, loadedIni.data()[2].first);
+    CPPUNIT_ASSERT_EQUAL("bar"s, loadedIni.data()[2].second.find("foo")->second);
+    checkLoadedFile(loadedIni, "core:a core:b mirrors:c extra:a extra:b mirrors:c ");
+#ifdef CPP_UTILITIES_USE_STANDARD_FILESYSTEM
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("each file parsed and cached once", 3_st, loader.cachedFileCount());
+#endif
+    const auto loadedInis = loader.load({ mainPath, mirrorsPath });
+    CPPUNIT_ASSERT_EQUAL(2_st, loadedInis.size());
+    checkLoadedFile(loadedInis[0], "core:a core:b mirrors:c extra:a extra:b mirrors:c ");
+    checkLoadedFile(loadedInis[1], ":a :b mirrors:c ");
+    writeFile(morePath, "Server = b2\n");
+    checkLoadedFile(loader.load(mainPath), "core:a core:b2 mirrors:c extra:a extra:b2 mirrors:c ");
+    loader.clearCache();
+    CPPUNIT_ASSERT_EQUAL(0_st, loader.cachedFileCount());
+    writeFile(mirrorsPath, "Include = include-missing.ini\n");
+    CPPUNIT_ASSERT_THROW(loader.load(mainPath), std::ios_base::failure);
 }
 
 /*!
@@ -512,6 +697,107 @@ void IoTests::testAdvancedIniFile()
 #pragma GCC diagnostic pop
 #endif
     CPPUNIT_ASSERT_EQUAL(originalContents, newFile.str());
+
+    // parse from buffer; the result should be the same
+    AdvancedIniFile iniFromBuffer;
+    iniFromBuffer.parse(std::string_view(originalContents));
+    std::stringstream newFileFromBuffer;
+    iniFromBuffer.make(newFileFromBuffer);
+    CPPUNIT_ASSERT_EQUAL(originalContents, newFileFromBuffer.str());
+    CPPUNIT_ASSERT_EQUAL(ini.sections.size(), iniFromBuffer.sections.size());
+    CPPUNIT_ASSERT_EQUAL(ini.sections[1].fields.back().followingInlineComment, iniFromBuffer.sections[1].fields.back().followingInlineComment);
+
+    // test writing only modified elements
+    AdvancedIniFile trackedIni;
+    trackedIni.parse(originalContents, IniFileParseOptions::TrackSource);
+    CPPUNIT_ASSERT_MESSAGE("no edits if nothing modified", trackedIni.makeEdits(originalContents).empty());
+    trackedIni.findField("extra", "Include").value()->value = "/etc/pacman.d/other-mirrorlist";
+    auto edits = trackedIni.makeEdits(originalContents);
+    CPPUNIT_ASSERT_EQUAL(1_st, edits.size());
+    CPPUNIT_ASSERT_EQUAL("Include = /etc/pacman.d/other-mirrorlist\n"s, edits.front().replacement);
+    CPPUNIT_ASSERT_EQUAL(
+        "Include = /etc/pacman.d/mirrorlist\n"sv, std::string_view(originalContents).substr(edits.front().offset, edits.front().size));
+    auto editedContents = originalContents;
+    AdvancedIniFile::applyEdits(editedContents, edits);
+    std::stringstream modifiedFile;
+    trackedIni.make(modifiedFile);
+    CPPUNIT_ASSERT_EQUAL(modifiedFile.str(), editedContents);
+
+    // test that formatting of unmodified elements is preserved
+    const auto compactContents = "[a]\nfoo=bar\nbar  =  baz   # comment\n[b]\nfoo=bar\n"s;
+    AdvancedIniFile compactIni;
+    compactIni.parse(compactContents, IniFileParseOptions::TrackSource);
+    compactIni.sections[1].fields[0].value = "foo";
+    compactIni.sections[0].fields.erase(compactIni.sections[0].fields.begin());
+    compactIni.sections[0].fields.emplace_back(AdvancedIniFile::Field{ .key = "new", .value = "field" });
+    std::stringstream compactFile;
+    compactIni.make(compactFile, compactContents);
+    CPPUNIT_ASSERT_EQUAL("[a]\nbar  =  baz   # comment\nnew= field\n[b]\nfoo= foo\n"s, compactFile.str());
+    editedContents = compactContents;
+    AdvancedIniFile::applyEdits(editedContents, compactIni.makeEdits(compactContents));
+    CPPUNIT_ASSERT_EQUAL(compactFile.str(), editedContents);
+
+    // test appending elements after an element not terminated by a line break
+    for (const auto &[unterminatedContents, expectedContents] : { std::pair("[a]\nfoo=bar"s, "[a]\nfoo=bar\nnew= x\n[b]\n"s),
+             std::pair("[a]\nfoo=bar # c"s, "[a]\nfoo=bar # c\nnew= x\n[b]\n"s) }) {
+        AdvancedIniFile unterminatedIni;
+        unterminatedIni.parse(unterminatedContents, IniFileParseOptions::TrackSource);
+        unterminatedIni.sections.back().fields.emplace_back(AdvancedIniFile::Field{ .key = "new", .value = "x" });
+        unterminatedIni.sections.emplace_back(AdvancedIniFile::Section{ .name = "b" });
+        std::stringstream unterminatedFile;
+        unterminatedIni.make(unterminatedFile, unterminatedContents);
+        CPPUNIT_ASSERT_EQUAL(expectedContents, unterminatedFile.str());
+        editedContents = unterminatedContents;
+        AdvancedIniFile::applyEdits(editedContents, unterminatedIni.makeEdits(unterminatedContents));
+        CPPUNIT_ASSERT_EQUAL(expectedContents, editedContents);
+    }
+
+    // test finding sections and fields via index
+    auto index = AdvancedIniFileIndex(ini);
+    for (const auto &section : ini.sections) {
+        const auto indexedSection = index.findSection(section.name);
+        CPPUNIT_ASSERT_MESSAGE("same section found via index", indexedSection == ini.findSection(section.name));
+        for (const auto &field : section.fields) {
+            CPPUNIT_ASSERT_MESSAGE("same field found via index", index.findField(indexedSection, field.key) == indexedSection->findField(field.key));
+        }
+    }
+    CPPUNIT_ASSERT_MESSAGE("section not present", index.findSection("extr") == ini.sectionEnd());
+    CPPUNIT_ASSERT_MESSAGE("field not present", !index.findField("extra", "Includ").has_value());
+    CPPUNIT_ASSERT_EQUAL("/etc/pacman.d/mirrorlist"s, index.findField("extra", "Include").value()->value);
+
+    // test duplicates and detection of added sections/fields
+    auto &extraSection = ini.sections.emplace_back();
+    extraSection.name = "extra";
+    extraSection.fields.emplace_back().key = "Server";
+    extraSection.fields.emplace_back().key = "Foo";
+    extraSection.fields.emplace_back().key = "Server";
+    index.invalidate();
+    auto firstExtra = index.findSection("extra");
+    CPPUNIT_ASSERT_EQUAL(1_st, firstExtra->fields.size());
+    auto secondExtra = index.findSection(firstExtra, "extra");
+    CPPUNIT_ASSERT(secondExtra == ini.sections.end() - 1);
+    CPPUNIT_ASSERT_MESSAGE("no third section", index.findSection(secondExtra, "extra") == ini.sectionEnd());
+    auto firstServer = index.findField(secondExtra, "Server");
+    CPPUNIT_ASSERT(firstServer == secondExtra->fields.begin());
+    auto secondServer = index.findField(secondExtra, firstServer, "Server");
+    CPPUNIT_ASSERT(secondServer == secondExtra->fields.begin() + 2);
+    CPPUNIT_ASSERT(index.findField(secondExtra, secondServer, "Server") == secondExtra->fieldEnd());
+
+    // test invalidation after renaming
+    secondExtra->name = "renamed";
+    index.invalidate();
+    CPPUNIT_ASSERT(index.findSection("renamed") == ini.sections.end() - 1);
+    CPPUNIT_ASSERT_MESSAGE("no second section anymore", index.findSection(index.findSection("extra"), "extra") == ini.sectionEnd());
+
+    // test invalidation after erasing and then adding a field (which keeps the number and location of fields)
+    auto &renamedFields = secondExtra->fields;
+    CPPUNIT_ASSERT(index.findField(secondExtra, "Foo") == renamedFields.begin() + 1);
+    renamedFields.erase(renamedFields.begin() + 1);
+    renamedFields.emplace_back().key = "Bar";
+    index.invalidate();
+    CPPUNIT_ASSERT_MESSAGE("erased field not present", index.findField(secondExtra, "Foo") == secondExtra->fieldEnd());
+    CPPUNIT_ASSERT(index.findField(secondExtra, "Bar") == renamedFields.begin() + 2);
+    CPPUNIT_ASSERT(index.findField(secondExtra, index.findField(secondExtra, "Server"), "Server") == renamedFields.begin() + 1);
 }
 
 /*!
@@ -635,6 +921,15 @@ void IoTests::testReadFile()
     // fail by exceeding max size
     CPPUNIT_ASSERT_THROW(readFile(iniFilePath, 10), std::ios_base::failure);
 
+    // read into a buffer which is reused
+    auto buffer = std::string("previous contents which are longer than the file and therefore definitely need to be replaced");
+    readFile(testFilePath("täst.txt"), buffer);
+    CPPUNIT_ASSERT_EQUAL("file with non-ASCII character 'ä' in its name\n"s, buffer);
+    readFile(iniFilePath, buffer, 200);
+    CPPUNIT_ASSERT_EQUAL(readFile(iniFilePath), buffer);
+    CPPUNIT_ASSERT_THROW(readFile(iniFilePath, buffer, 10), std::ios_base::failure);
+    CPPUNIT_ASSERT_THROW(readFile(testFilePath("täst.txt") + ".non-existing", buffer), std::ios_base::failure);
+
     // handle UTF-8 in path and file contents correctly via NativeFileStream
 #if !defined(PLATFORM_WINDOWS) || defined(CPP_UTILITIES_USE_NATIVE_FILE_BUFFER)
     CPPUNIT_ASSERT_EQUAL("file with non-ASCII character 'ä' in its name\n"s, readFile(testFilePath("täst.txt")));
@@ -649,6 +944,64 @@ void IoTests::testWriteFile()
     const string path(workingCopyPath("test.ini", WorkingCopyMode::NoCopy));
     writeFile(path, "some contents");
     CPPUNIT_ASSERT_EQUAL("some contents"s, readFile(path));
+
+    // replace file atomically and durably
+    writeFile(path, "new contents", WriteFileOptions::Durable);
+    CPPUNIT_ASSERT_EQUAL("new contents"s, readFile(path));
+    writeFile(path, "synced in place", WriteFileOptions::SyncFile);
+    CPPUNIT_ASSERT_EQUAL("synced in place"s, readFile(path));
+
+    // replace multiple files via batch
+    const auto otherPath = workingCopyPath("test2.ini", WorkingCopyMode::NoCopy);
+    {
+        auto batch = FileWriteBatch();
+        batch.writeFile(path, "batch contents 1");
+        batch.writeFile(otherPath, "batch contents 2");
+        CPPUNIT_ASSERT_EQUAL(2_st, batch.pendingFileCount());
+        CPPUNIT_ASSERT_EQUAL_MESSAGE("file not replaced before commit", "synced in place"s, readFile(path));
+        batch.commit();
+        CPPUNIT_ASSERT_EQUAL(0_st, batch.pendingFileCount());
+    }
+    CPPUNIT_ASSERT_EQUAL("batch contents 1"s, readFile(path));
+    CPPUNIT_ASSERT_EQUAL("batch contents 2"s, readFile(otherPath));
+
+    // discard pending files on destruction
+    {
+        auto batch = FileWriteBatch(WriteFileOptions::None);
+        batch.writeFile(path, "discarded contents");
+    }
+    CPPUNIT_ASSERT_EQUAL("batch contents 1"s, readFile(path));
+
+#ifdef PLATFORM_UNIX
+    // replace the file a symlink points to (keeping the symlink and the permissions of the file)
+    const auto linkPath = workingCopyPath("test-link.ini", WorkingCopyMode::NoCopy);
+    std::filesystem::remove(linkPath);
+    std::filesystem::create_symlink("test.ini", linkPath);
+    std::filesystem::permissions(path, std::filesystem::perms::owner_read | std::filesystem::perms::owner_write);
+    writeFile(linkPath, "contents via symlink", WriteFileOptions::Durable);
+    CPPUNIT_ASSERT_MESSAGE("symlink preserved", std::filesystem::is_symlink(linkPath));
+    CPPUNIT_ASSERT_EQUAL("contents via symlink"s, readFile(path));
+    CPPUNIT_ASSERT_MESSAGE("permissions preserved",
+        std::filesystem::status(path).permissions() == (std::filesystem::perms::owner_read | std::filesystem::perms::owner_write));
+    {
+        auto batch = FileWriteBatch();
+        batch.writeFile(linkPath, "batch contents via symlink");
+        batch.commit();
+    }
+    CPPUNIT_ASSERT_MESSAGE("symlink preserved by batch", std::filesystem::is_symlink(linkPath));
+    CPPUNIT_ASSERT_EQUAL("batch contents via symlink"s, readFile(path));
+
+    // replace read-only file durably via batch (the temporary file has the target's permissions when being flushed)
+    std::filesystem::permissions(path, std::filesystem::perms::owner_read);
+    {
+        auto batch = FileWriteBatch();
+        batch.writeFile(path, "read-only contents");
+        batch.commit();
+    }
+    CPPUNIT_ASSERT_EQUAL("read-only contents"s, readFile(path));
+    CPPUNIT_ASSERT_MESSAGE("read-only permissions preserved", std::filesystem::status(path).permissions() == std::filesystem::perms::owner_read);
+    std::filesystem::permissions(path, std::filesystem::perms::owner_read | std::filesystem::perms::owner_write);
+#endif
 }
 
 /*!
@@ -787,6 +1140,41 @@ void IoTests::testNativeFileStream()
     CPPUNIT_ASSERT(!fileStream2.is_open());
     CPPUNIT_ASSERT_EQUAL("barfoo"s, readFile(txtFilePath, 7));
 }
+
+/*!
+ * \brief Tests scatter-gather IO of the NativeFileStream class.
+ */
+void IoTests::testNativeFileStreamScatterGather()
+{
+    const auto path = workingCopyPath("scatter-gather", WorkingCopyMode::Cleanup);
+    writeFile(path, std::string_view());
+    auto fileStream = NativeFileStream();
+    fileStream.exceptions(ios_base::failbit | ios_base::badbit);
+    fileStream.open(path, ios_base::in | ios_base::out | ios_base::trunc | ios_base::binary);
+
+    // write via stream and directly via descriptor intermixed
+    fileStream << "<";
+    CPPUNIT_ASSERT_EQUAL(19_st, fileStream.writeGathered({ "header|"sv, ""sv, "body|"sv, "trailer"sv }));
+    CPPUNIT_ASSERT_EQUAL(static_cast<NativeFileStream::pos_type>(20), fileStream.tellp());
+    fileStream << ">";
+    CPPUNIT_ASSERT_EQUAL(2_st, fileStream.writeGatheredAt(1, { "H"sv, "E"sv }));
+    CPPUNIT_ASSERT_EQUAL(static_cast<NativeFileStream::pos_type>(21), fileStream.tellp());
+
+    // read back positional and at the current position
+    char head[8], body[5], tail[5];
+    CPPUNIT_ASSERT_EQUAL(13_st, fileStream.readScatteredAt(0, { { head, sizeof(head) }, { body, sizeof(body) } }));
+    CPPUNIT_ASSERT_EQUAL("<HEader|"sv, std::string_view(head, sizeof(head)));
+    CPPUNIT_ASSERT_EQUAL("body|"sv, std::string_view(body, sizeof(body)));
+    fileStream.seekg(13);
+    CPPUNIT_ASSERT_EQUAL(static_cast<char>(fileStream.get()), 't');
+    CPPUNIT_ASSERT_EQUAL(5_st, fileStream.readScattered({ { tail, 2 }, { tail + 2, sizeof(tail) - 2 } }));
+    CPPUNIT_ASSERT_EQUAL("raile"sv, std::string_view(tail, sizeof(tail)));
+    CPPUNIT_ASSERT_EQUAL(static_cast<char>(fileStream.get()), 'r');
+    CPPUNIT_ASSERT_EQUAL(static_cast<char>(fileStream.get()), '>');
+    CPPUNIT_ASSERT_EQUAL(0_st, fileStream.readScattered({ { tail, sizeof(tail) } }));
+    fileStream.close();
+    CPPUNIT_ASSERT_EQUAL("<HEader|body|trailer>"s, readFile(path, 21));
+}
 #endif
 
 #ifdef CPP_UTILITIES_USE_LIBARCHIVE
@@ -817,5 +1205,138 @@ void IoTests::testExtractingArchive()
     CPPUNIT_ASSERT_EQUAL("bar"s, subsubdir.at(0).name);
     CPPUNIT_ASSERT_EQUAL(ArchiveFileType::Regular, subsubdir.at(0).type);
     CPPUNIT_ASSERT_EQUAL(std::string(), subsubdir.at(0).content);
+
+    // stream file contents chunk-wise
+    auto streamedContents = std::map<std::string, std::string>();
+    auto completedFiles = std::vector<std::string>();
+    streamThroughArchive(archivePath, FilePredicate(), [&](std::string_view path, const ArchiveFile &file, const ArchiveFileChunk &chunk) {
+        auto &content = streamedContents[argsToString(path, '/', file.name)];
+        CPPUNIT_ASSERT_EQUAL(static_cast<std::uint64_t>(content.size()), chunk.offset);
+        if (chunk.isLast) {
+            CPPUNIT_ASSERT(chunk.data.empty());
+            completedFiles.emplace_back(argsToString(path, '/', file.name));
+        }
+        content.append(chunk.data);
+        return false;
+    });
+    CPPUNIT_ASSERT_EQUAL(3_st, completedFiles.size());
+    CPPUNIT_ASSERT_EQUAL("testfile\n"s, streamedContents.at("/test.txt"));
+    CPPUNIT_ASSERT_EQUAL("some file\n"s, streamedContents.at("subdir/nested-testfile.txt"));
+    CPPUNIT_ASSERT_EQUAL(std::string(), streamedContents.at("subdir/foo/bar"));
+
+    // extract files into compact map
+    const auto compactContents = extractFilesCompact(archivePath);
+    CPPUNIT_ASSERT_EQUAL(archiveContents.size(), compactContents.directories().size());
+    auto compactDirectory = compactContents.directories().begin();
+    for (const auto &[directory, files] : archiveContents) {
+        CPPUNIT_ASSERT_EQUAL(std::string_view(directory), compactDirectory->path);
+        CPPUNIT_ASSERT_EQUAL(files.size(), compactDirectory->size());
+        auto compactFile = compactDirectory->begin();
+        for (const auto &file : files) {
+            CPPUNIT_ASSERT_EQUAL(std::string_view(file.name), compactFile->name);
+            CPPUNIT_ASSERT_EQUAL(std::string_view(file.content), compactFile->content);
+            CPPUNIT_ASSERT_EQUAL(file.type, compactFile->type);
+            CPPUNIT_ASSERT_EQUAL(file.modificationTime, compactFile->modificationTime);
+            ++compactFile;
+        }
+        ++compactDirectory;
+    }
+    const auto *const compactSubdir = compactContents.findDirectory("subdir");
+    CPPUNIT_ASSERT(compactSubdir);
+    CPPUNIT_ASSERT_EQUAL("some file\n"sv, compactSubdir->begin()->content);
+    CPPUNIT_ASSERT(!compactContents.findDirectory("subdir/bar"));
+
+    // stream files from mapped archive; content of stored members points into the mapping
+    const auto mappedArchive = MappedArchive(archivePath);
+    auto mappedContents = std::map<std::string, std::string_view>();
+    streamThroughArchive(mappedArchive, FilePredicate(), [&](std::string_view path, const ArchiveFile &file, const ArchiveFileChunk &chunk) {
+        if (!chunk.isLast) {
+            CPPUNIT_ASSERT(mappedArchive.contains(chunk.data));
+            mappedContents[argsToString(path, '/', file.name)] = chunk.data;
+        }
+        return false;
+    });
+    CPPUNIT_ASSERT_EQUAL("testfile\n"sv, mappedContents.at("/test.txt"));
+    CPPUNIT_ASSERT_EQUAL("some file\n"sv, mappedContents.at("subdir/nested-testfile.txt"));
+
+    // list entries without extracting them
+    const auto listing = listArchive(archivePath);
+    const auto &entries = listing.entries();
+    CPPUNIT_ASSERT_EQUAL(4_st, entries.size());
+    CPPUNIT_ASSERT_EQUAL("subdir/foo"sv, entries[0].path);
+    CPPUNIT_ASSERT_EQUAL(ArchiveEntryType::Directory, entries[0].type);
+    CPPUNIT_ASSERT_EQUAL("subdir/nested-testfile.txt"sv, entries[2].path);
+    CPPUNIT_ASSERT_EQUAL(ArchiveEntryType::Regular, entries[2].type);
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::uint64_t>(10), entries[2].size);
+    CPPUNIT_ASSERT_EQUAL("test.txt"sv, entries[3].path);
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::uint64_t>(9), entries[3].size);
+    CPPUNIT_ASSERT_EQUAL(2024, entries[3].modificationTime.year());
+
+    // extract single files via index
+    const auto indexPath = workingCopyPath("archive-test.zip.index", WorkingCopyMode::NoCopy);
+    const auto index = ArchiveIndex::loadOrBuild(archivePath, indexPath);
+    CPPUNIT_ASSERT(index.isSeekable());
+    CPPUNIT_ASSERT_EQUAL(4_st, index.entries().size());
+    const auto *const indexEntry = index.find("subdir/nested-testfile.txt");
+    CPPUNIT_ASSERT(indexEntry);
+    CPPUNIT_ASSERT_EQUAL(static_cast<std::uint64_t>(10), indexEntry->size);
+    CPPUNIT_ASSERT(!index.find("subdir/missing.txt"));
+    const auto loadedIndex = ArchiveIndex::load(archivePath, indexPath);
+    CPPUNIT_ASSERT_EQUAL(indexEntry->headerOffset, loadedIndex.find("subdir/nested-testfile.txt")->headerOffset);
+    const auto extractedFile = loadedIndex.extractFile("subdir/nested-testfile.txt");
+    CPPUNIT_ASSERT(extractedFile.has_value());
+    CPPUNIT_ASSERT_EQUAL("nested-testfile.txt"s, extractedFile->name);
+    CPPUNIT_ASSERT_EQUAL("some file\n"s, extractedFile->content);
+    CPPUNIT_ASSERT_EQUAL("testfile\n"s, loadedIndex.extractFile("test.txt")->content);
+    CPPUNIT_ASSERT(!loadedIndex.extractFile("subdir/foo").has_value());
+
+    // reject corrupted/truncated index and rebuild it via loadOrBuild()
+    const auto indexContents = readFile(indexPath);
+    const auto corruptedIndexPath = workingCopyPath("archive-test.zip.corrupted-index", WorkingCopyMode::NoCopy);
+    auto corruptedIndex = indexContents;
+    std::fill_n(corruptedIndex.begin() + 44, 8, '\xFF'); // entry count
+    writeFile(corruptedIndexPath, corruptedIndex);
+    CPPUNIT_ASSERT_THROW(ArchiveIndex::load(archivePath, corruptedIndexPath), ArchiveException);
+    CPPUNIT_ASSERT_EQUAL(4_st, ArchiveIndex::loadOrBuild(archivePath, corruptedIndexPath).entries().size());
+    CPPUNIT_ASSERT_EQUAL(4_st, ArchiveIndex::load(archivePath, corruptedIndexPath).entries().size());
+    corruptedIndex = indexContents;
+    std::fill_n(corruptedIndex.begin() + 52, 8, '\x7F'); // size of first path
+    writeFile(corruptedIndexPath, corruptedIndex);
+    CPPUNIT_ASSERT_THROW(ArchiveIndex::load(archivePath, corruptedIndexPath), ArchiveException);
+    corruptedIndex = indexContents;
+    corruptedIndex[52 + 1 + loadedIndex.entries().front().path.size() + 28] = '\x03'; // type of first entry
+    writeFile(corruptedIndexPath, corruptedIndex);
+    CPPUNIT_ASSERT_THROW(ArchiveIndex::load(archivePath, corruptedIndexPath), ArchiveException);
+    writeFile(corruptedIndexPath, std::string_view(indexContents).substr(0, indexContents.size() - 10));
+    CPPUNIT_ASSERT_THROW(ArchiveIndex::load(archivePath, corruptedIndexPath), ArchiveException);
+    CPPUNIT_ASSERT_EQUAL(4_st, ArchiveIndex::loadOrBuild(archivePath, corruptedIndexPath).entries().size());
+
+    // extract files of Zip archive in parallel
+    const auto parallelContents = extractFilesInParallel(archivePath, FilePredicate(), 2);
+    CPPUNIT_ASSERT_EQUAL(archiveContents.size(), parallelContents.size());
+    for (const auto &[directory, files] : archiveContents) {
+        const auto &parallelFiles = parallelContents.at(directory);
+        CPPUNIT_ASSERT_EQUAL(files.size(), parallelFiles.size());
+        for (auto i = std::size_t(); i != files.size(); ++i) {
+            CPPUNIT_ASSERT_EQUAL(files[i].name, parallelFiles[i].name);
+            CPPUNIT_ASSERT_EQUAL(files[i].content, parallelFiles[i].content);
+        }
+    }
+
+    // walk through multiple archives in parallel preserving the order
+    const auto archivePaths = std::vector<std::string>{ archivePath, archivePath, archivePath };
+    auto walkedFiles = std::vector<std::string>();
+    walkThroughArchivesInParallel(
+        archivePaths, [](const char *, const char *fileName, mode_t) { return std::string_view(fileName) != "bar"; },
+        [&](std::string_view, std::string_view path, ArchiveFile &&file) {
+            walkedFiles.emplace_back(argsToString(path, '/', file.name));
+            return false;
+        },
+        ParallelArchiveFlags::PreserveOrder, 4);
+    CPPUNIT_ASSERT_EQUAL(6_st, walkedFiles.size());
+    for (auto i = std::size_t(); i != walkedFiles.size(); i += 2) {
+        CPPUNIT_ASSERT_EQUAL("subdir/nested-testfile.txt"s, walkedFiles[i]);
+        CPPUNIT_ASSERT_EQUAL("/test.txt"s, walkedFiles[i + 1]);
+    }
 }
 #endif
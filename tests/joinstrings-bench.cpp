@@ -0,0 +1,97 @@
+#include "../chrono/datetime.h"
+#include "../conversion/stringconversion.h"
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+using namespace CppUtilities;
+
+/*!
+ * \brief Joins \a strings like joinStrings() did before it copied the parts via std::char_traits::copy().
+ */
+static string legacyJoinStrings(const vector<string> &strings, string_view delimiter, bool omitEmpty, string_view leftClosure,
+    string_view rightClosure)
+{
+    string res;
+    if (!strings.size()) {
+        return res;
+    }
+    std::size_t entries = 0, size = 0;
+    for (const auto &str : strings) {
+        if (omitEmpty && str.empty()) {
+            continue;
+        }
+        size += str.size();
+        ++entries;
+    }
+    if (!entries) {
+        return res;
+    }
+    size += (entries * leftClosure.size()) + (entries * rightClosure.size()) + ((entries - 1) * delimiter.size());
+    res.reserve(size);
+    for (const auto &str : strings) {
+        if (omitEmpty && str.empty()) {
+            continue;
+        }
+        if (!res.empty()) {
+            res.append(delimiter);
+        }
+        res.append(leftClosure);
+        res.append(str);
+        res.append(rightClosure);
+    }
+    return res;
+}
+
+int main()
+{
+    cout << "Benchmarking joinStrings() vs. previous implementation" << endl;
+
+    // simulate joining file paths for a manifest
+    auto paths = vector<string>();
+    paths.reserve(500000u);
+    for (auto i = 0u; i != 500000u; ++i) {
+        paths.emplace_back("usr/share/some-package/data/subdirectory-" + to_string(i % 100) + "/file-" + to_string(i) + ".dat");
+    }
+    constexpr auto iterations = 20u;
+
+    auto t1 = DateTime::exactGmtNow();
+    auto size1 = size_t();
+    for (auto i = 0u; i != iterations; ++i) {
+        size1 += legacyJoinStrings(paths, "\n", false, "\"", "\"").size();
+    }
+    auto t2 = DateTime::exactGmtNow();
+    const auto diff1 = t2 - t1;
+    cout << "previous implementation: " << diff1.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto size2 = size_t();
+    for (auto i = 0u; i != iterations; ++i) {
+        size2 += joinStrings(paths, "\n", false, "\"", "\"").size();
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diff2 = t2 - t1;
+    cout << "joinStrings(): " << diff2.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto size3 = size_t();
+    auto manifest = string();
+    for (auto i = 0u; i != iterations; ++i) {
+        manifest.clear();
+        joinStrings(manifest, paths, "\n", false, "\"", "\"");
+        size3 += manifest.size();
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diff3 = t2 - t1;
+    cout << "joinStrings() with reused output: " << diff3.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    cout << "total size (should be equal): " << size1 << ", " << size2 << ", " << size3 << endl;
+    cout << "factor (previous / joinStrings()): " << (static_cast<double>(diff1.totalTicks()) / static_cast<double>(diff2.totalTicks())) << endl;
+    cout << "factor (previous / joinStrings() with reused output): "
+         << (static_cast<double>(diff1.totalTicks()) / static_cast<double>(diff3.totalTicks())) << endl;
+
+    return 0;
+}
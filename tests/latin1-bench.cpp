@@ -0,0 +1,97 @@
+#include "../chrono/datetime.h"
+#include "../conversion/stringconversion.h"
+
+#include <iconv.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace CppUtilities;
+
+/*!
+ * \brief Converts \a input like convertLatin1ToUtf8() and convertUtf8ToLatin1() did before they have been
+ *        implemented natively (using a cached iconv descriptor).
+ */
+static StringData convertViaIconv(iconv_t descriptor, const string &input, size_t outputSize)
+{
+    auto *inputBuffer = const_cast<char *>(input.data());
+    auto inputBytesLeft = input.size(), outputBytesLeft = outputSize;
+    auto *const outputBuffer = static_cast<char *>(malloc(outputSize));
+    auto *currentOutputOffset = outputBuffer;
+    iconv(descriptor, &inputBuffer, &inputBytesLeft, &currentOutputOffset, &outputBytesLeft);
+    return StringData(unique_ptr<char[], StringDataDeleter>(outputBuffer), static_cast<size_t>(currentOutputOffset - outputBuffer));
+}
+
+int main()
+{
+    cout << "Benchmarking native Latin-1/UTF-8 conversion vs. iconv" << endl;
+
+    // simulate text fields from legacy-encoded tags; most are ASCII, some contain umlauts
+    constexpr auto fieldCount = 2000000u;
+    auto latin1Fields = vector<string>(), utf8Fields = vector<string>();
+    latin1Fields.reserve(fieldCount);
+    utf8Fields.reserve(fieldCount);
+    for (auto i = 0u; i != fieldCount; ++i) {
+        if (i % 4) {
+            latin1Fields.emplace_back("Some Artist - Some Album - Some Title of track number " + to_string(i));
+            utf8Fields.emplace_back(latin1Fields.back());
+        } else {
+            latin1Fields.emplace_back("Die \xC4rzte - Schrei nach Liebe " + to_string(i));
+            utf8Fields.emplace_back("Die \xC3\x84rzte - Schrei nach Liebe " + to_string(i));
+        }
+    }
+    const auto toUtf8Descriptor = iconv_open("UTF-8", "ISO-8859-1"), toLatin1Descriptor = iconv_open("ISO-8859-1", "UTF-8");
+
+    auto t1 = DateTime::exactGmtNow();
+    auto size1 = size_t();
+    for (const auto &field : latin1Fields) {
+        size1 += convertViaIconv(toUtf8Descriptor, field, field.size() * 2).second;
+    }
+    for (const auto &field : utf8Fields) {
+        size1 += convertViaIconv(toLatin1Descriptor, field, field.size()).second;
+    }
+    auto t2 = DateTime::exactGmtNow();
+    const auto diff1 = t2 - t1;
+    cout << "iconv: " << diff1.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto size2 = size_t();
+    for (const auto &field : latin1Fields) {
+        size2 += convertLatin1ToUtf8(field.data(), field.size()).second;
+    }
+    for (const auto &field : utf8Fields) {
+        size2 += convertUtf8ToLatin1(field.data(), field.size()).second;
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diff2 = t2 - t1;
+    cout << "convertLatin1ToUtf8()/convertUtf8ToLatin1(): " << diff2.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto size3 = size_t();
+    auto buffer = string();
+    auto toUtf8 = Latin1ToUtf8Converter();
+    auto toLatin1 = Utf8ToLatin1Converter();
+    for (const auto &field : latin1Fields) {
+        buffer.resize(Latin1ToUtf8Converter::maxOutputSize(field.size()));
+        size3 += toUtf8.convert(field, buffer.data(), buffer.size()).bytesWritten;
+    }
+    for (const auto &field : utf8Fields) {
+        buffer.resize(Utf8ToLatin1Converter::maxOutputSize(field.size()));
+        size3 += toLatin1.convert(field, buffer.data(), buffer.size()).bytesWritten;
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diff3 = t2 - t1;
+    cout << "Latin1ToUtf8Converter/Utf8ToLatin1Converter with reused buffer: " << diff3.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    iconv_close(toUtf8Descriptor);
+    iconv_close(toLatin1Descriptor);
+    cout << "total size (should be equal): " << size1 << ", " << size2 << ", " << size3 << endl;
+    cout << "factor (iconv / native): " << (static_cast<double>(diff1.totalTicks()) / static_cast<double>(diff2.totalTicks())) << endl;
+    cout << "factor (iconv / native with reused buffer): " << (static_cast<double>(diff1.totalTicks()) / static_cast<double>(diff3.totalTicks()))
+         << endl;
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include "../chrono/datetime.h"
+#include "../conversion/stringconversion.h"
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace CppUtilities;
+
+/*!
+ * \brief Formats \a number like numberToString() did before it used a lookup table for decimal numbers.
+ */
+static string legacyNumberToString(std::int64_t number, std::int64_t base = 10)
+{
+    const auto negative = number < 0;
+    auto resSize = std::size_t();
+    if (negative) {
+        number = -number, resSize = 1;
+    }
+    auto n = number;
+    do {
+        n /= base, ++resSize;
+    } while (n);
+    auto res = string(resSize, '\0');
+    auto resIter = res.end();
+    do {
+        *(--resIter) = digitToChar<char>(static_cast<char>(number % base));
+        number /= base;
+    } while (number);
+    if (negative) {
+        *(--resIter) = '-';
+    }
+    return res;
+}
+
+/*!
+ * \brief Formats \a number like numberToString() did before it used std::to_chars().
+ */
+static string legacyNumberToString(double number, int base = 10)
+{
+    stringstream ss;
+    ss << setbase(base) << number;
+    return ss.str();
+}
+
+int main()
+{
+    cout << "Benchmarking numberToString() vs. previous implementation" << endl;
+
+    // simulate values of a report (e.g. sizes, durations and ratios); when appending, the numbers are formatted
+    // into a line buffer which is reused for the next line
+    auto randomEngine = std::mt19937_64();
+    auto integers = vector<std::int64_t>(), smallIntegers = vector<std::int64_t>();
+    auto floatingPointNumbers = vector<double>();
+    for (auto i = 0u; i != 2000000u; ++i) {
+        integers.emplace_back(static_cast<std::int64_t>(randomEngine() >> 20) - (1ll << 43));
+        smallIntegers.emplace_back(static_cast<std::int64_t>(randomEngine() % 10000u));
+        floatingPointNumbers.emplace_back(static_cast<double>(randomEngine() % 1000000u) / 1000.0);
+    }
+
+    auto t1 = DateTime::exactGmtNow();
+    auto size1 = size_t();
+    for (const auto number : integers) {
+        size1 += legacyNumberToString(number).size();
+    }
+    for (const auto number : smallIntegers) {
+        size1 += legacyNumberToString(number).size();
+    }
+    auto t2 = DateTime::exactGmtNow();
+    const auto diffInt1 = t2 - t1;
+    cout << "integers, previous implementation: " << diffInt1.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto size2 = size_t();
+    for (const auto number : integers) {
+        size2 += numberToString(number).size();
+    }
+    for (const auto number : smallIntegers) {
+        size2 += numberToString(number).size();
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diffInt2 = t2 - t1;
+    cout << "integers, numberToString(): " << diffInt2.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto size3 = size_t();
+    auto line = string();
+    for (auto i = size_t(); i != integers.size(); ++i) {
+        numberToString(line, integers[i]);
+        numberToString(line, smallIntegers[i]);
+        if (!(i % 8)) {
+            size3 += line.size();
+            line.clear();
+        }
+    }
+    size3 += line.size();
+    t2 = DateTime::exactGmtNow();
+    const auto diffInt3 = t2 - t1;
+    cout << "integers, numberToString() appending: " << diffInt3.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto floatSize1 = size_t();
+    for (const auto number : floatingPointNumbers) {
+        floatSize1 += legacyNumberToString(number).size();
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diffFloat1 = t2 - t1;
+    cout << "floating point numbers, previous implementation: " << diffFloat1.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto floatSize2 = size_t();
+    for (const auto number : floatingPointNumbers) {
+        floatSize2 += numberToString(number).size();
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diffFloat2 = t2 - t1;
+    cout << "floating point numbers, numberToString(): " << diffFloat2.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto floatSize3 = size_t();
+    line.clear();
+    for (auto i = size_t(); i != floatingPointNumbers.size(); ++i) {
+        numberToString(line, floatingPointNumbers[i]);
+        if (!(i % 16)) {
+            floatSize3 += line.size();
+            line.clear();
+        }
+    }
+    floatSize3 += line.size();
+    t2 = DateTime::exactGmtNow();
+    const auto diffFloat3 = t2 - t1;
+    cout << "floating point numbers, numberToString() appending: " << diffFloat3.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    cout << "total size of integers (should be equal): " << size1 << ", " << size2 << ", " << size3 << endl;
+    cout << "total size of floating point numbers (might differ as precision is no longer limited to 6 digits): " << floatSize1 << ", "
+         << floatSize2 << ", " << floatSize3 << endl;
+    cout << "factor for integers (previous / numberToString()): "
+         << (static_cast<double>(diffInt1.totalTicks()) / static_cast<double>(diffInt2.totalTicks())) << endl;
+    cout << "factor for integers (previous / numberToString() appending): "
+         << (static_cast<double>(diffInt1.totalTicks()) / static_cast<double>(diffInt3.totalTicks())) << endl;
+    cout << "factor for floating point numbers (previous / numberToString()): "
+         << (static_cast<double>(diffFloat1.totalTicks()) / static_cast<double>(diffFloat2.totalTicks())) << endl;
+    cout << "factor for floating point numbers (previous / numberToString() appending): "
+         << (static_cast<double>(diffFloat1.totalTicks()) / static_cast<double>(diffFloat3.totalTicks())) << endl;
+
+    return 0;
+}
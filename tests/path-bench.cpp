@@ -0,0 +1,74 @@
+#include "../chrono/datetime.h"
+#include "../io/path.h"
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace CppUtilities;
+
+int main()
+{
+    cout << "Benchmarking PathComponents/normalizePath() vs. std::filesystem::path" << endl;
+
+    // simulate paths of archive entries
+    constexpr auto pathCount = 1000000u;
+    auto paths = vector<string>();
+    paths.reserve(pathCount);
+    for (auto i = 0u; i != pathCount; ++i) {
+        paths.emplace_back("usr/share/doc/package-" + to_string(i % 1000) + "/./examples//../html/page-" + to_string(i) + ".html");
+    }
+
+    // iterate over components
+    auto componentCount1 = size_t(), componentCount2 = size_t();
+    auto t1 = DateTime::exactGmtNow();
+    for (const auto &path : paths) {
+        for (const auto &component : filesystem::path(path)) {
+            componentCount1 += !component.empty();
+        }
+    }
+    auto t2 = DateTime::exactGmtNow();
+    const auto diff1 = t2 - t1;
+    cout << "iterating via std::filesystem::path: " << diff1.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    for (const auto &path : paths) {
+        for (const auto component : PathComponents(path)) {
+            componentCount2 += !component.empty();
+        }
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diff2 = t2 - t1;
+    cout << "iterating via PathComponents: " << diff2.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    // normalize
+    auto normalizedSize1 = size_t(), normalizedSize2 = size_t();
+    t1 = DateTime::exactGmtNow();
+    for (const auto &path : paths) {
+        normalizedSize1 += filesystem::path(path).lexically_normal().native().size();
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diff3 = t2 - t1;
+    cout << "normalizing via std::filesystem::path: " << diff3.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto buffer = string();
+    for (const auto &path : paths) {
+        buffer.resize(path.size());
+        normalizedSize2 += normalizePath(path, buffer.data()).size();
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diff4 = t2 - t1;
+    cout << "normalizing via normalizePath(): " << diff4.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    cout << "components (should be equal): " << componentCount1 << ", " << componentCount2 << endl;
+    cout << "normalized size (should be equal): " << normalizedSize1 << ", " << normalizedSize2 << endl;
+    cout << "factor iterating (std::filesystem::path / PathComponents): "
+         << (static_cast<double>(diff1.totalTicks()) / static_cast<double>(diff2.totalTicks())) << endl;
+    cout << "factor normalizing (std::filesystem::path / normalizePath()): "
+         << (static_cast<double>(diff3.totalTicks()) / static_cast<double>(diff4.totalTicks())) << endl;
+
+    return 0;
+}
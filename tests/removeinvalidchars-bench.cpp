@@ -0,0 +1,87 @@
+#include "../chrono/datetime.h"
+#include "../io/path.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace CppUtilities;
+
+/*!
+ * \brief Removes invalid characters like removeInvalidChars() did before it has been optimized.
+ */
+static void removeInvalidCharsViaReplace(std::string &fileName)
+{
+    size_t startPos = 0;
+    static const char invalidPathChars[] = { '\"', '<', '>', '?', '!', '*', '|', '/', ':', '\\', '\n' };
+    for (const char *i = invalidPathChars, *end = invalidPathChars + sizeof(invalidPathChars); i != end; ++i) {
+        startPos = fileName.find(*i);
+        while (startPos != string::npos) {
+            fileName.replace(startPos, 1, string());
+            startPos = fileName.find(*i, startPos);
+        }
+    }
+}
+
+int main()
+{
+    cout << "Benchmarking removeInvalidChars() vs. its previous implementation" << endl;
+
+    // simulate file names generated from tag metadata; every 4th contains invalid characters
+    constexpr auto nameCount = 2000000u;
+    auto names = vector<string>();
+    names.reserve(nameCount);
+    for (auto i = 0u; i != nameCount; ++i) {
+        names.emplace_back(
+            i % 4 ? "Some Artist - Some Album - " + to_string(i) + " - Some Title.flac" : "AC/DC - Who? Me! - " + to_string(i) + " - \"Live\".flac");
+    }
+    auto contiguousNames = string();
+    auto nameEnds = vector<size_t>();
+    nameEnds.reserve(nameCount);
+    for (const auto &name : names) {
+        contiguousNames += name;
+        nameEnds.emplace_back(contiguousNames.size());
+    }
+    auto names1 = names, names2 = names;
+
+    auto t1 = DateTime::exactGmtNow();
+    auto size1 = size_t();
+    for (auto &name : names1) {
+        removeInvalidCharsViaReplace(name);
+        size1 += name.size();
+    }
+    auto t2 = DateTime::exactGmtNow();
+    const auto diff1 = t2 - t1;
+    cout << "previous implementation: " << diff1.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto size2 = size_t();
+    for (auto &name : names2) {
+        removeInvalidChars(name);
+        size2 += name.size();
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diff2 = t2 - t1;
+    cout << "removeInvalidChars(): " << diff2.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    removeInvalidChars(contiguousNames, nameEnds);
+    t2 = DateTime::exactGmtNow();
+    const auto diff3 = t2 - t1;
+    cout << "removeInvalidChars() batch: " << diff3.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    auto mismatches = 0u;
+    for (auto i = size_t(); i != nameCount; ++i) {
+        const auto begin = i ? nameEnds[i - 1] : size_t();
+        mismatches += contiguousNames.compare(begin, nameEnds[i] - begin, names2[i]) != 0;
+    }
+    cout << "mismatches of batch results (should be 0): " << mismatches << endl;
+    cout << "total size (should be equal): " << size1 << ", " << size2 << ", " << contiguousNames.size() << endl;
+    cout << "factor (previous / removeInvalidChars()): " << (static_cast<double>(diff1.totalTicks()) / static_cast<double>(diff2.totalTicks()))
+         << endl;
+    cout << "factor (previous / removeInvalidChars() batch): "
+         << (static_cast<double>(diff1.totalTicks()) / static_cast<double>(diff3.totalTicks())) << endl;
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include "../chrono/datetime.h"
+#include "../conversion/stringconversion.h"
+
+#include <iostream>
+#include <list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+using namespace CppUtilities;
+
+int main()
+{
+    cout << "Benchmarking lazy splitStringLazily() vs. container-returning splitString()/splitStringSimple()" << endl;
+
+    // simulate a large multi-line output of some command (like the output of "ldd" or "pacman -Ql")
+    auto output = string();
+    for (auto i = 0u; i != 2000000u; ++i) {
+        output += "/usr/lib/some-library-" + to_string(i) + ".so.1 => /usr/lib/some-library.so (0x00007f";
+        output += i % 10 ? "\n" : "\n\n";
+    }
+    const auto walkPart = [](string_view part) { return part.empty() ? size_t() : part.size() + static_cast<unsigned char>(part.front()); };
+
+    auto t1 = DateTime::exactGmtNow();
+    auto checksum1 = size_t();
+    for (const auto &part : splitString(output, "\n", EmptyPartsTreat::Omit)) {
+        checksum1 += walkPart(part);
+    }
+    auto t2 = DateTime::exactGmtNow();
+    const auto diff1 = t2 - t1;
+    cout << "splitString() (std::list<std::string>): " << diff1.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto checksum2 = size_t();
+    for (const auto &part : splitStringSimple<vector<string_view>>(output, "\n")) {
+        checksum2 += walkPart(part);
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diff2 = t2 - t1;
+    cout << "splitStringSimple() (std::vector<std::string_view>): " << diff2.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto checksum3 = size_t();
+    for (const auto part : splitStringLazily(output, "\n", EmptyPartsTreat::Omit)) {
+        checksum3 += walkPart(part);
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diff3 = t2 - t1;
+    cout << "splitStringLazily(): " << diff3.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    cout << "checksum (should be equal): " << checksum1 << ", " << checksum2 << ", " << checksum3 << endl;
+    cout << "factor (splitString() / lazy): " << (static_cast<double>(diff1.totalTicks()) / static_cast<double>(diff3.totalTicks())) << endl;
+    cout << "factor (splitStringSimple() / lazy): " << (static_cast<double>(diff2.totalTicks()) / static_cast<double>(diff3.totalTicks()))
+         << endl;
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include "../chrono/datetime.h"
+#include "../conversion/stringconversion.h"
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace CppUtilities;
+
+/*!
+ * \brief Parses \a string like bufferToNumber() did before it had a fast path (one character at a time).
+ */
+static std::int64_t legacyBufferToNumber(const char *string, std::size_t size, std::int64_t base = 10)
+{
+    if (!size) {
+        return 0;
+    }
+    const char *end = string + size;
+    for (; string != end && *string == ' '; ++string)
+        ;
+    if (string == end) {
+        return 0;
+    }
+    const bool negative = (*string == '-');
+    if (negative) {
+        ++string;
+    }
+    std::int64_t result = 0;
+    for (; string != end; ++string) {
+        Detail::raiseAndAdd(result, base, *string);
+    }
+    return negative ? -result : result;
+}
+
+int main()
+{
+    cout << "Benchmarking stringToNumber()/stringToNumbers() vs. previous implementation" << endl;
+
+    // simulate a CSV-like dump of sample tables (3 columns of different magnitude per line)
+    auto randomEngine = std::mt19937_64();
+    auto dump = string();
+    for (auto i = 0u; i != 2000000u; ++i) {
+        numberToString(dump, static_cast<std::int64_t>(randomEngine() % 100000u) - 50000);
+        dump += ',';
+        numberToString(dump, static_cast<std::int64_t>(randomEngine() >> 24));
+        dump += ',';
+        numberToString(dump, static_cast<std::int64_t>(randomEngine() % 256u));
+        dump += '\n';
+    }
+
+    auto t1 = DateTime::exactGmtNow();
+    auto sum1 = std::int64_t();
+    for (const auto line : splitStringLazily(dump, "\n", EmptyPartsTreat::Omit)) {
+        for (const auto value : splitStringLazily(line, ",")) {
+            sum1 += legacyBufferToNumber(value.data(), value.size());
+        }
+    }
+    auto t2 = DateTime::exactGmtNow();
+    const auto diff1 = t2 - t1;
+    cout << "previous implementation: " << diff1.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto sum2 = std::int64_t();
+    for (const auto line : splitStringLazily(dump, "\n", EmptyPartsTreat::Omit)) {
+        for (const auto value : splitStringLazily(line, ",")) {
+            sum2 += bufferToNumber<std::int64_t>(value.data(), value.size());
+        }
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diff2 = t2 - t1;
+    cout << "bufferToNumber(): " << diff2.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto sum3 = std::int64_t();
+    auto values = vector<std::int64_t>();
+    values.reserve(6000000u);
+    stringToNumbers(values, dump, ",\n");
+    for (const auto value : values) {
+        sum3 += value;
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diff3 = t2 - t1;
+    cout << "stringToNumbers(): " << diff3.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    cout << "sum (should be equal): " << sum1 << ", " << sum2 << ", " << sum3 << endl;
+    cout << "factor (previous / bufferToNumber()): " << (static_cast<double>(diff1.totalTicks()) / static_cast<double>(diff2.totalTicks()))
+         << endl;
+    cout << "factor (previous / stringToNumbers()): " << (static_cast<double>(diff1.totalTicks()) / static_cast<double>(diff3.totalTicks()))
+         << endl;
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include "../chrono/datetime.h"
+#include "../conversion/stringconversion.h"
+
+#include <iconv.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace CppUtilities;
+
+/*!
+ * \brief Converts \a input like convertUtf8ToUtf16LE() and convertUtf16LEToUtf8() did before they have been
+ *        implemented natively (using a cached iconv descriptor and a guessed output size).
+ */
+static StringData convertViaIconv(iconv_t descriptor, const string &input, size_t outputSize)
+{
+    auto *inputBuffer = const_cast<char *>(input.data());
+    auto inputBytesLeft = input.size(), outputBytesLeft = outputSize;
+    auto *const outputBuffer = static_cast<char *>(malloc(outputSize));
+    auto *currentOutputOffset = outputBuffer;
+    iconv(descriptor, &inputBuffer, &inputBytesLeft, &currentOutputOffset, &outputBytesLeft);
+    return StringData(unique_ptr<char[], StringDataDeleter>(outputBuffer), static_cast<size_t>(currentOutputOffset - outputBuffer));
+}
+
+int main()
+{
+    cout << "Benchmarking native UTF-8/UTF-16 conversion vs. iconv" << endl;
+
+    // simulate text fields from ID3v2/MP4 tags; most are ASCII, some contain umlauts or CJK characters
+    constexpr auto fieldCount = 2000000u;
+    auto utf8Fields = vector<string>();
+    utf8Fields.reserve(fieldCount);
+    for (auto i = 0u; i != fieldCount; ++i) {
+        switch (i % 4) {
+        case 0:
+            utf8Fields.emplace_back("Die Ärzte - Schrei nach Liebe " + to_string(i));
+            break;
+        case 1:
+            utf8Fields.emplace_back("坂本龍一 - 戦場のメリークリスマス " + to_string(i));
+            break;
+        default:
+            utf8Fields.emplace_back("Some Artist - Some Album - Some Title of track number " + to_string(i));
+        }
+    }
+    auto utf16Fields = vector<string>();
+    utf16Fields.reserve(fieldCount);
+    for (const auto &field : utf8Fields) {
+        const auto utf16 = convertUtf8ToUtf16LE(field.data(), field.size());
+        utf16Fields.emplace_back(utf16.first.get(), utf16.second);
+    }
+    const auto toUtf16Descriptor = iconv_open("UTF-16LE", "UTF-8"), toUtf8Descriptor = iconv_open("UTF-8", "UTF-16LE");
+
+    auto t1 = DateTime::exactGmtNow();
+    auto size1 = size_t();
+    for (const auto &field : utf8Fields) {
+        size1 += convertViaIconv(toUtf16Descriptor, field, field.size() * 2).second;
+    }
+    for (const auto &field : utf16Fields) {
+        size1 += convertViaIconv(toUtf8Descriptor, field, field.size() * 2).second;
+    }
+    auto t2 = DateTime::exactGmtNow();
+    const auto diff1 = t2 - t1;
+    cout << "iconv: " << diff1.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto size2 = size_t();
+    for (const auto &field : utf8Fields) {
+        size2 += convertUtf8ToUtf16LE(field.data(), field.size()).second;
+    }
+    for (const auto &field : utf16Fields) {
+        size2 += convertUtf16LEToUtf8(field.data(), field.size()).second;
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diff2 = t2 - t1;
+    cout << "convertUtf8ToUtf16LE()/convertUtf16LEToUtf8(): " << diff2.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    t1 = DateTime::exactGmtNow();
+    auto size3 = size_t();
+    auto buffer = string();
+    auto toUtf16 = Utf8ToUtf16Converter();
+    auto toUtf8 = Utf16ToUtf8Converter();
+    for (const auto &field : utf8Fields) {
+        buffer.resize(Utf8ToUtf16Converter::maxOutputSize(field.size()));
+        size3 += toUtf16.convert(field, buffer.data(), buffer.size()).bytesWritten;
+    }
+    for (const auto &field : utf16Fields) {
+        buffer.resize(Utf16ToUtf8Converter::maxOutputSize(field.size()));
+        size3 += toUtf8.convert(field, buffer.data(), buffer.size()).bytesWritten;
+    }
+    t2 = DateTime::exactGmtNow();
+    const auto diff3 = t2 - t1;
+    cout << "Utf8ToUtf16Converter/Utf16ToUtf8Converter with reused buffer: " << diff3.toString(TimeSpanOutputFormat::WithMeasures) << endl;
+
+    iconv_close(toUtf16Descriptor);
+    iconv_close(toUtf8Descriptor);
+    cout << "total size (should be equal): " << size1 << ", " << size2 << ", " << size3 << endl;
+    cout << "factor (iconv / native): " << (static_cast<double>(diff1.totalTicks()) / static_cast<double>(diff2.totalTicks())) << endl;
+    cout << "factor (iconv / native with reused buffer): " << (static_cast<double>(diff1.totalTicks()) / static_cast<double>(diff3.totalTicks()))
+         << endl;
+
+    return 0;
+}